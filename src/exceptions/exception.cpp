@@ -301,3 +301,23 @@ const char* tools::InvalidPatternException::description() const {
 tools::InvalidPatternException* tools::InvalidPatternException::clone() const {
 	return new InvalidPatternException();
 }
+
+tools::MalformedCompressedDataException::MalformedCompressedDataException(
+	size_t position
+) : _position(position) { }
+
+tools::MalformedCompressedDataException::MalformedCompressedDataException(
+	const MalformedCompressedDataException& other
+) : _position(other._position) { }
+
+const char* tools::MalformedCompressedDataException::description() const {
+	return "Compressed data is malformed.";
+}
+
+tools::MalformedCompressedDataException* tools::MalformedCompressedDataException::clone() const {
+	return new MalformedCompressedDataException(this->_position);
+}
+
+size_t tools::MalformedCompressedDataException::position() const {
+	return this->_position;
+}
@@ -412,6 +412,29 @@ namespace foundation::exceptions {
 
 		};
 
+		class MalformedCompressedDataException : public Exception {
+
+			private:
+				size_t _position;
+
+			public:
+
+				MalformedCompressedDataException(
+					size_t position);
+
+				MalformedCompressedDataException(
+					const MalformedCompressedDataException& other);
+
+				virtual ~MalformedCompressedDataException() = default;
+
+				virtual const char* description() const override;
+
+				virtual MalformedCompressedDataException* clone() const override;
+
+				size_t position() const;
+
+		};
+
 	}
 
 }
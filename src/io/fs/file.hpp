@@ -53,13 +53,11 @@ namespace foundation::io::fs {
 		template<typename T = uint8_t>
 		Data<T> read(size_t count) {
 			if (this->_mode == Mode::asWrite) throw FileModeException();
-			size_t toRead = math::min(sizeof(T) * count, this->_size - this->_position);
-			auto read = Data<T>::fromCBuffer([this](void* buffer, size_t length){
-				fread(buffer, sizeof(T), length / sizeof(T), this->_stream);
-				return length;
-			}, toRead);
-			this->_position += toRead;
-			return read;
+			size_t toRead = math::min(count, (this->_size - this->_position) / sizeof(T));
+			DataBuilder<T> builder(toRead);
+			builder.commit(fread(builder.reserve(toRead), sizeof(T), toRead, this->_stream));
+			this->_position += builder.length() * sizeof(T);
+			return builder.build();
 		}
 
 		template<typename T>
@@ -71,21 +69,37 @@ namespace foundation::io::fs {
 			return result;
 		}
 
+		// Maps the whole file read-only. Pages are loaded from the page cache on
+		// first access, and are only copied if the data is mutated.
+		template<typename T = uint8_t>
+		Data<T> map() {
+			if (this->_mode != Mode::asRead) throw FileModeException();
+			return Data<T>::fromMappedFile(fileno(this->_stream), this->_size);
+		}
+
 		template<typename T = uint8_t>
 		Data<T> readToEnd() {
-			Data<T> buffer;
-			while (this->_position < this->_size) {
-				buffer.append(this->read(16384));
+			if (this->_mode == Mode::asRead && this->_position < this->_size && this->_position % sizeof(T) == 0) {
+				try {
+					Data<T> mapped = this->map<T>();
+					size_t offset = this->_position / sizeof(T);
+					Data<T> result(mapped, offset, mapped.length() - offset);
+					this->_position = this->_size;
+					fseek(this->_stream, this->_position, SEEK_SET);
+					return result;
+				} catch (const foundation::exceptions::memory::AllocationException&) { }
 			}
-			return buffer;
+			return this->template read<T>((this->_size - this->_position) / sizeof(T));
 		}
 
 		template<typename T = uint8_t>
 		void write(const Data<T>& data) {
 			if (this->_mode == Mode::asRead) throw FileModeException();
-			this->_position += data.count() * sizeof(T);
+			this->_position += data.length() * sizeof(T);
 			this->_size = math::max(this->_position, this->_size);
-			fwrite(data.items(), sizeof(T), data.count(), this->_stream);
+			data.forEachChunk([this](const T* items, size_t length) {
+				fwrite(items, sizeof(T), length, this->_stream);
+			});
 		}
 
 	private:
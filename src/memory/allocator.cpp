@@ -6,22 +6,72 @@
 // See license in LICENSE.
 //
 
-#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
 #include "../tools/math.hpp"
 
 #include "../exceptions/exception.hpp"
 
+#include "./arena.hpp"
+#include "./statistics.hpp"
+
+#ifdef FOUNDATION_MEMORY_POOL
+#include "./pool.hpp"
+#endif
+
 #include "allocator.hpp"
 
 using namespace foundation::memory;
 using namespace foundation::exceptions::memory;
 using namespace foundation::tools;
 
+static inline bool _isMapped(
+	size_t size
+) {
+	return size >= FOUNDATION_BUFFER_MAPPED_THRESHOLD;
+}
+
+static inline size_t _roundUp(
+	size_t size,
+	size_t multiple
+) {
+	return ((size + multiple - 1) / multiple) * multiple;
+}
+
+static inline size_t _mappedSize(
+	size_t size
+) {
+	static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	return _roundUp(size, pageSize);
+}
+
+static inline void _advise(
+	void* mem,
+	size_t size
+) {
+#if defined(FOUNDATION_MEMORY_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+	madvise(mem, size, MADV_HUGEPAGE);
+#else
+	(void)mem;
+	(void)size;
+#endif
+}
+
+static void* _map(
+	size_t size
+) noexcept(false) {
+	void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mem == MAP_FAILED) throw AllocationException(size);
+	_advise(mem, size);
+	return mem;
+}
+
 void* Allocator::operator new(
 	size_t size
 ) noexcept(false) {
-	return allocate(size);
+	return allocate(size, false);
 }
 
 void* Allocator::operator new(
@@ -33,27 +83,154 @@ void* Allocator::operator new(
 }
 
 void Allocator::operator delete(
-	void *ptr
+	void *ptr,
+	size_t size
 ) throw() {
-	deallocate(ptr);
+	deallocate(ptr, size);
 }
 
 uint64_t Allocator::calculateBufferLength(
 	const uint64_t& minimumLength
 ) {
-	return (uint64_t)pow(2, ceil(log2((math::max<double>(minimumLength, FOUNDATION_BLOCK_SIZE) / FOUNDATION_BLOCK_SIZE)))) * FOUNDATION_BLOCK_SIZE;;
+	uint64_t blocks = (minimumLength + FOUNDATION_BLOCK_SIZE - 1) / FOUNDATION_BLOCK_SIZE;
+	if (blocks <= 1) return FOUNDATION_BLOCK_SIZE;
+	return ((uint64_t)1 << (64 - __builtin_clzll(blocks - 1))) * FOUNDATION_BLOCK_SIZE;
+}
+
+uint64_t Allocator::calculateBufferLength(
+	const uint64_t& minimumLength,
+	const uint64_t& currentLength,
+	Growth growth
+) {
+	switch (growth) {
+		case Growth::exact:
+			return minimumLength;
+		case Growth::oneAndAHalf: {
+			uint64_t result = math::max<uint64_t>(currentLength + currentLength / 2, minimumLength);
+			return ((result + FOUNDATION_BLOCK_SIZE - 1) / FOUNDATION_BLOCK_SIZE) * FOUNDATION_BLOCK_SIZE;
+		}
+		default:
+			return calculateBufferLength(minimumLength);
+	}
 }
 
 void* Allocator::allocate(
-	size_t size
+	size_t size,
+	bool zeroed
 ) noexcept(false) {
-	void *mem = calloc(size, sizeof(uint8_t));
+#ifdef FOUNDATION_MEMORY_STATISTICS
+	Statistics::allocated(size);
+#endif
+	Arena* arena = Arena::current();
+	if (arena != nullptr) {
+		void *mem = arena->allocate(size);
+		if (mem != nullptr) {
+			if (zeroed) memset(mem, 0, size);
+			return mem;
+		}
+	}
+#ifdef FOUNDATION_MEMORY_POOL
+	void *mem = Pool::allocate(size);
+	if (zeroed) memset(mem, 0, size);
+#else
+	void *mem = zeroed ? calloc(size, sizeof(uint8_t)) : malloc(size);
 	if (!mem) throw AllocationException(size);
+#endif
 	return mem;
 }
 
 void Allocator::deallocate(
-	void* ptr
+	void* ptr,
+	size_t size
 ) {
+#ifdef FOUNDATION_MEMORY_STATISTICS
+	if (ptr != nullptr) Statistics::deallocated(size);
+#endif
+	Arena* arena = Arena::owner(ptr);
+	if (arena != nullptr) {
+		arena->deallocate(ptr);
+		return;
+	}
+#ifdef FOUNDATION_MEMORY_POOL
+	Pool::deallocate(ptr, size);
+#else
+	(void)size;
 	free(ptr);
+#endif
+}
+
+void* Allocator::reallocateBuffer(
+	void* ptr,
+	size_t oldSize,
+	size_t newSize
+) noexcept(false) {
+
+	if (ptr == nullptr) oldSize = 0;
+
+	if (newSize == 0) {
+		deallocateBuffer(ptr, oldSize);
+		return nullptr;
+	}
+
+	if (ptr != nullptr && _isMapped(oldSize) && _isMapped(newSize)) {
+
+		size_t oldMapped = _mappedSize(oldSize);
+		size_t newMapped = _mappedSize(newSize);
+
+		if (oldMapped == newMapped) return ptr;
+
+#ifdef __linux__
+		void* mem = mremap(ptr, oldMapped, newMapped, MREMAP_MAYMOVE);
+		if (mem == MAP_FAILED) throw AllocationException(newSize);
+		if (newMapped > oldMapped) _advise(mem, newMapped);
+		return mem;
+#else
+		if (newMapped < oldMapped) {
+			munmap((uint8_t*)ptr + newMapped, oldMapped - newMapped);
+			return ptr;
+		}
+#endif
+
+	}
+
+	void* mem = nullptr;
+
+	if (_isMapped(newSize)) {
+		mem = _map(_mappedSize(newSize));
+	} else if (posix_memalign(&mem, FOUNDATION_BUFFER_ALIGNMENT, _roundUp(newSize, FOUNDATION_BUFFER_ALIGNMENT)) != 0) {
+		throw AllocationException(newSize);
+	}
+
+	if (ptr != nullptr) {
+		memcpy(mem, ptr, math::min(oldSize, newSize));
+		deallocateBuffer(ptr, oldSize);
+	}
+
+	return mem;
+
+}
+
+void Allocator::deallocateBuffer(
+	void* ptr,
+	size_t size
+) {
+	if (ptr == nullptr) return;
+	if (_isMapped(size)) munmap(ptr, _mappedSize(size));
+	else free(ptr);
+}
+
+void* Allocator::mapFile(
+	int descriptor,
+	size_t size
+) noexcept(false) {
+	void* mem = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if (mem == MAP_FAILED) throw AllocationException(size);
+	return mem;
+}
+
+void Allocator::unmapFile(
+	void* ptr,
+	size_t size
+) {
+	if (ptr != nullptr) munmap(ptr, size);
 }
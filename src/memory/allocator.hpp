@@ -9,31 +9,75 @@
 #ifndef foundation_allocator_hpp
 #define foundation_allocator_hpp
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define FOUNDATION_BLOCK_SIZE 32
+#define FOUNDATION_BUFFER_ALIGNMENT 64
+#define FOUNDATION_BUFFER_MAPPED_THRESHOLD (1024 * 1024)
 
 namespace foundation::memory {
 
+	// How buffers grow when they run out of capacity.
+	//
+	// - `twice` rounds up to the next power of two (the default).
+	// - `oneAndAHalf` grows by half the current capacity.
+	// - `exact` allocates exactly what is needed.
+	enum class Growth {
+		twice,
+		oneAndAHalf,
+		exact
+	};
+
 	class Allocator {
 
 	public:
 
 		void *operator new(size_t size) noexcept(false);
 		void *operator new(size_t size, void *ptr) noexcept(false);
-		void operator delete(void *ptr) throw();
+		void operator delete(void *ptr, size_t size) throw();
 
 	protected:
 
 		static uint64_t calculateBufferLength(
 			const uint64_t& minimumLength);
 
+		static uint64_t calculateBufferLength(
+			const uint64_t& minimumLength,
+			const uint64_t& currentLength,
+			Growth growth);
+
 		static void* allocate(
-			size_t size
+			size_t size,
+			bool zeroed = true
 		) noexcept(false);
 
 		static void deallocate(
-			void* ptr);
+			void* ptr,
+			size_t size);
+
+		// Buffers are aligned to `FOUNDATION_BUFFER_ALIGNMENT`. Buffers of
+		// `FOUNDATION_BUFFER_MAPPED_THRESHOLD` bytes or more are mapped directly
+		// from the kernel, and are grown without copying where supported.
+		static void* reallocateBuffer(
+			void* ptr,
+			size_t oldSize,
+			size_t newSize
+		) noexcept(false);
+
+		static void deallocateBuffer(
+			void* ptr,
+			size_t size);
+
+		// Maps the first `size` bytes of the file behind `descriptor` read-only.
+		static void* mapFile(
+			int descriptor,
+			size_t size
+		) noexcept(false);
+
+		static void unmapFile(
+			void* ptr,
+			size_t size);
 
 	};
 
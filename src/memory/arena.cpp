@@ -0,0 +1,225 @@
+//
+// arena.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "../exceptions/exception.hpp"
+
+#include "./arena.hpp"
+
+#define FOUNDATION_ARENA_ALIGNMENT 16
+#define FOUNDATION_ARENA_BLOCK_BITS 18
+#define FOUNDATION_ARENA_ADDRESS_BITS 48
+#define FOUNDATION_ARENA_REGISTRY_BITS 15
+
+static_assert(((size_t)1 << FOUNDATION_ARENA_BLOCK_BITS) == FOUNDATION_ARENA_BLOCK_SIZE);
+
+using namespace foundation::memory;
+using namespace foundation::exceptions::memory;
+
+// Blocks are aligned to their size, so the block of any pointer is found by
+// masking. The registry maps block addresses to their arena through a two level
+// table indexed by the block number, and is read without locking, which keeps
+// `Arena::owner` cheap on every deallocation. Each leaf covers 8 GB of address
+// space. Leaves are allocated when a block first lands in their range and are
+// never freed, so readers never see one disappear. Addresses are expected to fit
+// in 48 bits, as they do in user space on current 64 bit platforms.
+typedef std::atomic<Arena*> _Leaf[(size_t)1 << FOUNDATION_ARENA_REGISTRY_BITS];
+
+static std::atomic<_Leaf*> _registry[(size_t)1 << (FOUNDATION_ARENA_ADDRESS_BITS - FOUNDATION_ARENA_BLOCK_BITS - FOUNDATION_ARENA_REGISTRY_BITS)];
+static std::atomic<size_t> _registryCount(0);
+static pthread_mutex_t _registryMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static thread_local Arena* _current = nullptr;
+
+// Returns nullptr if `ptr` is outside the address range of the registry, or if
+// `create` is false and no block has been registered in its range.
+static std::atomic<Arena*>* _registrySlot(
+	const void* ptr,
+	bool create
+) noexcept(false) {
+
+	uintptr_t block = (uintptr_t)ptr >> FOUNDATION_ARENA_BLOCK_BITS;
+
+	if (block >> (FOUNDATION_ARENA_ADDRESS_BITS - FOUNDATION_ARENA_BLOCK_BITS) != 0) return nullptr;
+
+	std::atomic<_Leaf*>& entry = _registry[block >> FOUNDATION_ARENA_REGISTRY_BITS];
+
+	_Leaf* leaf = entry.load(std::memory_order_acquire);
+
+	if (leaf == nullptr) {
+		if (!create) return nullptr;
+		leaf = (_Leaf*)calloc(1, sizeof(_Leaf));
+		if (leaf == nullptr) throw AllocationException(sizeof(_Leaf));
+		entry.store(leaf, std::memory_order_release);
+	}
+
+	return &(*leaf)[block & (((uintptr_t)1 << FOUNDATION_ARENA_REGISTRY_BITS) - 1)];
+
+}
+
+static void _register(
+	void* block,
+	Arena* arena
+) noexcept(false) {
+	pthread_mutex_lock(&_registryMutex);
+	std::atomic<Arena*>* slot = nullptr;
+	try {
+		slot = _registrySlot(block, true);
+	} catch (...) {
+		pthread_mutex_unlock(&_registryMutex);
+		throw;
+	}
+	if (slot != nullptr) {
+		slot->store(arena, std::memory_order_release);
+		_registryCount++;
+	}
+	pthread_mutex_unlock(&_registryMutex);
+	if (slot == nullptr) throw AllocationException(FOUNDATION_ARENA_BLOCK_SIZE);
+}
+
+static void _unregister(
+	void* block
+) {
+	std::atomic<Arena*>* slot = _registrySlot(block, false);
+	if (slot == nullptr) return;
+	slot->store(nullptr, std::memory_order_release);
+	_registryCount--;
+}
+
+Arena* Arena::current() {
+	return _current;
+}
+
+Arena* Arena::owner(
+	const void* ptr
+) {
+	if (ptr == nullptr || _registryCount.load(std::memory_order_relaxed) == 0) return nullptr;
+	std::atomic<Arena*>* slot = _registrySlot(ptr, false);
+	if (slot == nullptr) return nullptr;
+	return slot->load(std::memory_order_acquire);
+}
+
+Arena::Arena(
+) : _previous(nullptr),
+	_blocks(nullptr),
+	_cursor(nullptr),
+	_end(nullptr),
+	_used(0),
+	_reserved(0),
+	_live(0) { }
+
+Arena::~Arena() {
+
+#ifdef DEBUG
+	if (this->_live > 0) {
+		fprintf(stderr, "Foundation: %zu object(s) outlived their arena.\n", this->_live.load());
+		abort();
+	}
+#endif
+
+	while (_current == this) {
+		this->pop();
+	}
+
+	while (this->_blocks != nullptr) {
+		Block* block = this->_blocks;
+		this->_blocks = block->next;
+		_unregister(block);
+		free(block);
+	}
+
+}
+
+void Arena::push() {
+	this->_previous = _current;
+	_current = this;
+}
+
+void Arena::pop() {
+	if (_current != this) return;
+	_current = this->_previous;
+	this->_previous = nullptr;
+}
+
+void Arena::within(
+	std::function<void()> todo
+) {
+	(void)this->within<void*>([&]() {
+		todo();
+		return nullptr;
+	});
+}
+
+void* Arena::allocate(
+	size_t size
+) noexcept(false) {
+
+	size = (size + FOUNDATION_ARENA_ALIGNMENT - 1) & ~((size_t)FOUNDATION_ARENA_ALIGNMENT - 1);
+
+	if (size > FOUNDATION_ARENA_BLOCK_SIZE - FOUNDATION_ARENA_ALIGNMENT) return nullptr;
+
+	if (this->_cursor == nullptr || this->_cursor + size > this->_end) {
+
+		void* mem = nullptr;
+
+		if (posix_memalign(&mem, FOUNDATION_ARENA_BLOCK_SIZE, FOUNDATION_ARENA_BLOCK_SIZE) != 0) {
+			throw AllocationException(FOUNDATION_ARENA_BLOCK_SIZE);
+		}
+
+		try {
+			_register(mem, this);
+		} catch (...) {
+			free(mem);
+			throw;
+		}
+
+		Block* block = (Block*)mem;
+		block->next = this->_blocks;
+		this->_blocks = block;
+
+		this->_cursor = (uint8_t*)mem + FOUNDATION_ARENA_ALIGNMENT;
+		this->_end = (uint8_t*)mem + FOUNDATION_ARENA_BLOCK_SIZE;
+		this->_reserved += FOUNDATION_ARENA_BLOCK_SIZE;
+
+	}
+
+	void* result = this->_cursor;
+
+	this->_cursor += size;
+	this->_used += size;
+
+#ifdef DEBUG
+	this->_live++;
+#endif
+
+	return result;
+
+}
+
+void Arena::deallocate(
+	void*
+) {
+#ifdef DEBUG
+	this->_live--;
+#endif
+}
+
+size_t Arena::used() const {
+	return this->_used;
+}
+
+size_t Arena::reserved() const {
+	return this->_reserved;
+}
+
+size_t Arena::live() const {
+	return this->_live;
+}
@@ -0,0 +1,99 @@
+//
+// arena.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_arena_hpp
+#define foundation_arena_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+
+#define FOUNDATION_ARENA_BLOCK_SIZE 262144
+
+namespace foundation::memory {
+
+	// Region allocator.
+	//
+	// While an arena is the current scope on a thread, every
+	// `Allocator::operator new` on that thread bump-allocates from it. Releasing
+	// an object that lives in an arena runs its destructor but does not free its
+	// memory – the whole region is freed when the arena is destroyed.
+	//
+	// Objects must not outlive their arena. In DEBUG builds the arena aborts if
+	// any of its objects are still alive when it is destroyed.
+	class Arena {
+
+	public:
+
+		static Arena* current();
+
+		static Arena* owner(
+			const void* ptr);
+
+		Arena();
+		Arena(const Arena&) = delete;
+		Arena(Arena&&) = delete;
+
+		~Arena();
+
+		void push();
+		void pop();
+
+		void within(
+			std::function<void()> todo);
+
+		template<typename T>
+		T within(
+			std::function<T()> todo
+		) {
+
+			this->push();
+
+			try {
+				T result = todo();
+				this->pop();
+				return result;
+			} catch (...) {
+				this->pop();
+				throw;
+			}
+
+		}
+
+		void* allocate(
+			size_t size
+		) noexcept(false);
+
+		void deallocate(
+			void* ptr);
+
+		size_t used() const;
+		size_t reserved() const;
+		size_t live() const;
+
+	private:
+
+		struct Block {
+			Block* next;
+		};
+
+		Arena* _previous;
+		Block* _blocks;
+		uint8_t* _cursor;
+		uint8_t* _end;
+		size_t _used;
+		size_t _reserved;
+		std::atomic<size_t> _live;
+
+	};
+
+}
+
+#endif /* foundation_arena_hpp */
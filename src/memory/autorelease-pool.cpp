@@ -0,0 +1,129 @@
+//
+// autorelease-pool.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <stdlib.h>
+
+#include "./autorelease-pool.hpp"
+
+using namespace foundation::memory;
+
+static thread_local AutoreleasePool* _current = nullptr;
+
+AutoreleasePool* AutoreleasePool::current() {
+	return _current;
+}
+
+bool AutoreleasePool::defer(
+	const Object* object,
+	void (*release)(const Object*)
+) {
+	if (_current == nullptr) return false;
+	return _current->_add(object, release);
+}
+
+AutoreleasePool::AutoreleasePool(
+) : _previous(nullptr),
+	_chunks(nullptr),
+	_spare(nullptr) { }
+
+AutoreleasePool::~AutoreleasePool() {
+
+	this->drain();
+
+	while (_current == this) {
+		this->pop();
+	}
+
+	if (this->_spare != nullptr) {
+		free(this->_spare);
+	}
+
+}
+
+void AutoreleasePool::push() {
+	this->_previous = _current;
+	_current = this;
+}
+
+void AutoreleasePool::pop() {
+	if (_current != this) return;
+	_current = this->_previous;
+	this->_previous = nullptr;
+}
+
+void AutoreleasePool::within(
+	std::function<void()> todo
+) {
+	(void)this->within<void*>([&]() {
+		todo();
+		return nullptr;
+	});
+}
+
+void AutoreleasePool::drain() {
+
+	// Releasing an object may defer more releases into this pool, so the top
+	// chunk is re-read after every release.
+	while (this->_chunks != nullptr) {
+
+		Chunk* chunk = this->_chunks;
+
+		if (chunk->count == 0) {
+			this->_chunks = chunk->previous;
+			if (this->_spare == nullptr) {
+				this->_spare = chunk;
+			} else {
+				free(chunk);
+			}
+			continue;
+		}
+
+		Entry entry = chunk->entries[--chunk->count];
+
+		entry.release(entry.object);
+
+	}
+
+}
+
+size_t AutoreleasePool::count() const {
+	size_t result = 0;
+	for (Chunk* chunk = this->_chunks ; chunk != nullptr ; chunk = chunk->previous) {
+		result += chunk->count;
+	}
+	return result;
+}
+
+bool AutoreleasePool::_add(
+	const Object* object,
+	void (*release)(const Object*)
+) {
+
+	if (this->_chunks == nullptr || this->_chunks->count == FOUNDATION_AUTORELEASE_POOL_CHUNK_SIZE) {
+
+		Chunk* chunk = this->_spare;
+
+		if (chunk != nullptr) {
+			this->_spare = nullptr;
+		} else {
+			chunk = (Chunk*)malloc(sizeof(Chunk));
+			if (chunk == nullptr) return false;
+		}
+
+		chunk->previous = this->_chunks;
+		chunk->count = 0;
+
+		this->_chunks = chunk;
+
+	}
+
+	this->_chunks->entries[this->_chunks->count++] = { object, release };
+
+	return true;
+
+}
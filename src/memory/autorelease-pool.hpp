@@ -0,0 +1,107 @@
+//
+// autorelease-pool.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_autorelease_pool_hpp
+#define foundation_autorelease_pool_hpp
+
+#include <stddef.h>
+
+#include <functional>
+
+#define FOUNDATION_AUTORELEASE_POOL_CHUNK_SIZE 1023
+
+namespace foundation::memory {
+
+	class Object;
+
+	// Deferred release scope.
+	//
+	// While a pool is the current scope on a thread, a `Strong` marked with
+	// `autoreleased()` hands its object to the pool when released, instead of
+	// releasing it. Temporaries returned by chained APIs – like `String::trimmed`
+	// and `Array::map` – are marked this way. All other `Strong`s release
+	// immediately. The deferred objects are released in one batch when the pool
+	// is drained – which happens at the end of `within` and when the pool is
+	// destroyed.
+	//
+	// Pools nest. Releases always go to the innermost pool. A pool must be
+	// drained before any arena its objects were allocated in is destroyed.
+	class AutoreleasePool {
+
+	public:
+
+		static AutoreleasePool* current();
+
+		// Returns false if no pool is current on this thread, in which case the
+		// caller must release the object itself.
+		static bool defer(
+			const Object* object,
+			void (*release)(const Object*));
+
+		AutoreleasePool();
+		AutoreleasePool(const AutoreleasePool&) = delete;
+		AutoreleasePool(AutoreleasePool&&) = delete;
+
+		~AutoreleasePool();
+
+		void push();
+		void pop();
+
+		void within(
+			std::function<void()> todo);
+
+		template<typename T>
+		T within(
+			std::function<T()> todo
+		) {
+
+			this->push();
+
+			try {
+				T result = todo();
+				this->drain();
+				this->pop();
+				return result;
+			} catch (...) {
+				this->drain();
+				this->pop();
+				throw;
+			}
+
+		}
+
+		void drain();
+
+		size_t count() const;
+
+	private:
+
+		struct Entry {
+			const Object* object;
+			void (*release)(const Object*);
+		};
+
+		struct Chunk {
+			Chunk* previous;
+			size_t count;
+			Entry entries[FOUNDATION_AUTORELEASE_POOL_CHUNK_SIZE];
+		};
+
+		AutoreleasePool* _previous;
+		Chunk* _chunks;
+		Chunk* _spare;
+
+		bool _add(
+			const Object* object,
+			void (*release)(const Object*));
+
+	};
+
+}
+
+#endif /* foundation_autorelease_pool_hpp */
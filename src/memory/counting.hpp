@@ -0,0 +1,92 @@
+//
+// counting.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_counting_hpp
+#define foundation_counting_hpp
+
+#include <stddef.h>
+
+#include <atomic>
+
+#ifndef FOUNDATION_MEMORY_COUNTING
+#define FOUNDATION_MEMORY_COUNTING sequential
+#endif
+
+namespace foundation::memory {
+
+	// How retain counts are updated.
+	//
+	// - `sequential` uses sequentially consistent atomics (the default).
+	// - `acquireRelease` uses relaxed increments and acquire-release decrements.
+	// - `nonAtomic` uses plain loads and stores, and is only safe for objects that
+	//   never leave the thread that created them.
+	enum class Counting {
+		sequential,
+		acquireRelease,
+		nonAtomic
+	};
+
+	// The build-wide policy can be changed by defining
+	// `FOUNDATION_MEMORY_COUNTING`. Individual types can override it by
+	// specializing `CountingPolicy`.
+	//
+	//     template<>
+	//     struct foundation::memory::CountingPolicy<MyType> {
+	//         static constexpr Counting value = Counting::nonAtomic;
+	//     };
+	template<typename T>
+	struct CountingPolicy {
+		static constexpr Counting value = Counting::FOUNDATION_MEMORY_COUNTING;
+	};
+
+	template<Counting C>
+	class Counter {
+
+	public:
+
+		// Returns the count before the increment.
+		static inline size_t increment(std::atomic<size_t>& count) {
+			if constexpr (C == Counting::sequential) {
+				return count.fetch_add(1);
+			} else if constexpr (C == Counting::acquireRelease) {
+				return count.fetch_add(1, std::memory_order_relaxed);
+			} else {
+				size_t result = count.load(std::memory_order_relaxed);
+				count.store(result + 1, std::memory_order_relaxed);
+				return result;
+			}
+		}
+
+		// Returns the count after the decrement.
+		static inline size_t decrement(std::atomic<size_t>& count) {
+			if constexpr (C == Counting::sequential) {
+				return --count;
+			} else if constexpr (C == Counting::acquireRelease) {
+				return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+			} else {
+				size_t result = count.load(std::memory_order_relaxed) - 1;
+				count.store(result, std::memory_order_relaxed);
+				return result;
+			}
+		}
+
+		static inline size_t load(const std::atomic<size_t>& count) {
+			if constexpr (C == Counting::sequential) {
+				return count.load();
+			} else if constexpr (C == Counting::acquireRelease) {
+				return count.load(std::memory_order_acquire);
+			} else {
+				return count.load(std::memory_order_relaxed);
+			}
+		}
+
+	};
+
+}
+
+#endif /* foundation_counting_hpp */
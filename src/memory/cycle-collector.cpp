@@ -0,0 +1,585 @@
+//
+// cycle-collector.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/types.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../types/duration.hpp"
+#include "./object.hpp"
+
+#include "./cycle-collector.hpp"
+
+using namespace foundation::memory;
+using namespace foundation::types;
+
+namespace {
+
+	// Every object stores its own position, so tracking is a push and untracking
+	// a swap with the last object.
+	struct Registry {
+		std::vector<const Object*> objects;
+		size_t cursor = 0;
+	};
+
+	struct Node {
+		const Object* object;
+		size_t retainCount;
+		ssize_t count;
+		size_t references;
+		size_t edges;
+		size_t edgesCount;
+		bool alive;
+		bool retained;
+		size_t group;
+	};
+
+	enum class Phase {
+		idle,
+		discover,
+		mark,
+		gather,
+		collect,
+		release,
+		forget
+	};
+
+	// The examination in progress. Every object in it is retained by the
+	// collector, so none can be destroyed between steps. Deques are used, so
+	// growing never copies what has already been discovered.
+	struct State {
+		Phase phase = Phase::idle;
+		std::unordered_set<const Object*> seen;
+		std::unordered_map<const Object*, size_t> indices;
+		std::deque<Node> nodes;
+		std::deque<size_t> edges;
+		std::vector<size_t> stack;
+		std::vector<size_t> garbage;
+		size_t current = SIZE_MAX;
+		size_t position = 0;
+		size_t cursor = 0;
+	};
+
+}
+
+// Never destroyed, as objects may still be released during static destruction.
+static Registry* _registry = nullptr;
+static State* _state = nullptr;
+static pthread_mutex_t _registryMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t _collectorMutex = PTHREAD_MUTEX_INITIALIZER;
+
+static const size_t _spinsBeforeYield = 256;
+
+static inline void _pause() {
+#if defined(__x86_64__) || defined(__i386__)
+	_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+static inline double _now() {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec / 1000000000.0;
+}
+
+static inline size_t _find(
+	std::vector<size_t>& groups,
+	size_t group
+) {
+	while (groups[group] != group) {
+		groups[group] = groups[groups[group]];
+		group = groups[group];
+	}
+	return group;
+}
+
+// Takes the next tracked container and retains it, so it stays alive while it
+// is examined. Looks at no more than `limit` containers, and returns nullptr if
+// none was found – setting `isFinished` if the end of the registry is reached.
+static const Object* _next(
+	const std::unordered_set<const Object*>& seen,
+	size_t limit,
+	bool& isFinished
+) {
+
+	const Object* result = nullptr;
+
+	pthread_mutex_lock(&_registryMutex);
+
+	isFinished = _registry == nullptr || _registry->cursor == _registry->objects.size();
+
+	for ( ; !isFinished && limit > 0 ; limit--) {
+		const Object* object = _registry->objects[_registry->cursor++];
+		isFinished = _registry->cursor == _registry->objects.size();
+		if (seen.count(object) == 0 && object->retainIfAlive()) {
+			result = object;
+			isFinished = false;
+			break;
+		}
+	}
+
+	if (isFinished && _registry != nullptr) _registry->cursor = 0;
+
+	pthread_mutex_unlock(&_registryMutex);
+
+	return result;
+
+}
+
+// Adds a container already retained by the collector. Its count starts at its
+// retain count without the collector's retain, and every reference found inside
+// the graph is subtracted from it.
+static size_t _add(
+	State& state,
+	const Object* object
+) {
+	size_t index = state.nodes.size();
+	size_t retainCount = object->retainCount();
+	state.seen.insert(object);
+	state.indices[object] = index;
+	state.nodes.push_back({ object, retainCount, (ssize_t)retainCount - 1, 0, 0, 0, false, true, 0 });
+	state.stack.push_back(index);
+	return index;
+}
+
+// Follows one reference. Only containers are part of the graph – other objects
+// cannot hold references, so they cannot be part of a cycle, and are freed with
+// the containers holding them.
+static void _discover(
+	State& state,
+	CycleCollector::Report& report
+) {
+
+	if (state.current == SIZE_MAX) {
+		if (state.stack.size() == 0) {
+			state.phase = Phase::mark;
+			state.cursor = 0;
+			return;
+		}
+		state.current = state.stack.back();
+		state.stack.pop_back();
+		state.nodes[state.current].edges = state.edges.size();
+		report.examined++;
+		return;
+	}
+
+	Node& node = state.nodes[state.current];
+
+	// The container may have changed since the last step.
+	const Object* child = node.object->lockRetainedAt(node.references);
+
+	if (child == nullptr) {
+		state.current = SIZE_MAX;
+		return;
+	}
+
+	node.references++;
+
+	if (!child->isCollectable()) {
+		child->release();
+		return;
+	}
+
+	auto entry = state.indices.find(child);
+	size_t index;
+
+	if (entry != state.indices.end()) {
+		child->release();
+		index = entry->second;
+	} else {
+		index = _add(state, child);
+	}
+
+	state.nodes[index].count--;
+	state.edges.push_back(index);
+
+	node.edgesCount++;
+
+}
+
+// Follows one reference. Everything reachable from an object with outside
+// references is alive.
+static void _mark(
+	State& state
+) {
+
+	if (state.current != SIZE_MAX) {
+		const Node& node = state.nodes[state.current];
+		if (state.position == node.edgesCount) {
+			state.current = SIZE_MAX;
+			return;
+		}
+		size_t index = state.edges[node.edges + state.position++];
+		Node& child = state.nodes[index];
+		if (!child.alive) {
+			child.alive = true;
+			state.stack.push_back(index);
+		}
+		return;
+	}
+
+	if (state.stack.size() > 0) {
+		state.current = state.stack.back();
+		state.position = 0;
+		state.stack.pop_back();
+		return;
+	}
+
+	if (state.cursor == state.nodes.size()) {
+		state.phase = Phase::gather;
+		state.cursor = 0;
+		return;
+	}
+
+	Node& node = state.nodes[state.cursor];
+
+	if (node.count != 0 && !node.alive) {
+		node.alive = true;
+		state.stack.push_back(state.cursor);
+	}
+
+	state.cursor++;
+
+}
+
+static void _gather(
+	State& state
+) {
+
+	if (state.cursor == state.nodes.size()) {
+		state.phase = Phase::collect;
+		return;
+	}
+
+	Node& node = state.nodes[state.cursor];
+
+	if (!node.alive) {
+		node.group = state.garbage.size();
+		state.garbage.push_back(state.cursor);
+	}
+
+	state.cursor++;
+
+}
+
+// The graph may have changed since it was discovered. Garbage is only garbage
+// if its retain counts and references are still the ones that were examined –
+// then every reference to it is still held from inside the garbage itself.
+static bool _isUnchanged(
+	const State& state
+) {
+
+	for (size_t index : state.garbage) {
+
+		const Node& node = state.nodes[index];
+
+		if (node.object->retainCount() != node.retainCount) return false;
+		if (node.object->retainedCount() != node.references) return false;
+
+		size_t edge = node.edges;
+
+		for (size_t reference = 0 ; reference < node.references ; reference++) {
+			const Object* child = node.object->lockRetainedAt(reference);
+			if (child == nullptr) return false;
+			bool isCollectable = child->isCollectable();
+			auto entry = state.indices.find(child);
+			child->release();
+			if (!isCollectable) continue;
+			if (edge == node.edges + node.edgesCount || entry == state.indices.end() || entry->second != state.edges[edge++]) return false;
+		}
+
+		if (edge != node.edges + node.edgesCount) return false;
+
+	}
+
+	return true;
+
+}
+
+// Runs in one go, so it is bounded by the amount of garbage – not by the size
+// of the graph.
+static void _collect(
+	State& state,
+	CycleCollector::Report& report
+) {
+
+	state.phase = Phase::release;
+
+	if (state.garbage.size() == 0 || !_isUnchanged(state)) return;
+
+	std::vector<size_t> groups(state.garbage.size());
+
+	for (size_t idx = 0 ; idx < state.garbage.size() ; idx++) {
+		groups[idx] = idx;
+	}
+
+	for (size_t index : state.garbage) {
+		const Node& node = state.nodes[index];
+		for (size_t edge = node.edges ; edge < node.edges + node.edgesCount ; edge++) {
+			const Node& child = state.nodes[state.edges[edge]];
+			if (child.alive) continue;
+			size_t from = _find(groups, node.group);
+			size_t to = _find(groups, child.group);
+			if (from != to) groups[from] = to;
+		}
+	}
+
+	for (size_t idx = 0 ; idx < state.garbage.size() ; idx++) {
+		if (_find(groups, idx) == idx) report.cycles++;
+	}
+
+	report.collected += state.garbage.size();
+
+	// The collector's retains keep the garbage alive while the cycles are
+	// broken, so no object is destroyed while another container still lists it.
+	for (size_t index : state.garbage) {
+		((Object*)state.nodes[index].object)->releaseRetained();
+	}
+
+	for (size_t index : state.garbage) {
+		state.nodes[index].retained = false;
+		state.nodes[index].object->release();
+	}
+
+}
+
+// Releases and forgets one object – or a batch of references.
+static void _release(
+	State& state
+) {
+
+	state.garbage.clear();
+	state.stack.clear();
+	state.current = SIZE_MAX;
+
+	if (state.edges.size() > 0) {
+		state.edges.erase(state.edges.begin(), state.edges.begin() + std::min<size_t>(state.edges.size(), 256));
+		return;
+	}
+
+	if (state.nodes.size() == 0) {
+		state.phase = Phase::idle;
+		return;
+	}
+
+	Node& node = state.nodes.front();
+
+	state.indices.erase(node.object);
+
+	if (node.retained) node.object->release();
+
+	state.nodes.pop_front();
+
+}
+
+static void _abandon(
+	State& state
+) {
+	if (state.phase == Phase::idle || state.phase == Phase::forget) return;
+	state.phase = Phase::release;
+	while (state.phase != Phase::idle) {
+		_release(state);
+	}
+}
+
+// Works in small units – one reference at a time – so a step never runs much
+// past its deadline, however large the graph being examined is. Returns when
+// the deadline is reached or the pass over the registry is complete.
+static CycleCollector::Report _step(
+	double budget
+) {
+
+	CycleCollector::Report report = { 0, 0, 0, false };
+
+	if (_state == nullptr) _state = new State();
+
+	State& state = *_state;
+
+	double deadline = _now() + budget;
+
+	do {
+
+		switch (state.phase) {
+			case Phase::idle: {
+				// Sized up front at the start of a pass, as rehashing large tables
+				// would stall a step. No graph holds more containers than are tracked.
+				if (state.seen.size() == 0) {
+					size_t tracked = CycleCollector::tracked();
+					state.seen.reserve(tracked);
+					state.indices.reserve(tracked);
+				}
+				bool isFinished;
+				const Object* root = _next(state.seen, 256, isFinished);
+				if (root != nullptr) {
+					_add(state, root);
+					state.phase = Phase::discover;
+				} else if (isFinished) {
+					state.phase = Phase::forget;
+				}
+				break;
+			}
+			case Phase::discover:
+				_discover(state, report);
+				break;
+			case Phase::mark:
+				_mark(state);
+				break;
+			case Phase::gather:
+				_gather(state);
+				break;
+			case Phase::collect:
+				_collect(state, report);
+				break;
+			case Phase::release:
+				_release(state);
+				break;
+			case Phase::forget:
+				for (size_t idx = 0 ; idx < 256 && state.seen.size() > 0 ; idx++) {
+					state.seen.erase(state.seen.begin());
+				}
+				if (state.seen.size() == 0) {
+					state.phase = Phase::idle;
+					report.completed = true;
+					return report;
+				}
+				break;
+		}
+
+	} while (_now() < deadline);
+
+	return report;
+
+}
+
+bool CycleCollector::isEnabled() {
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+	return true;
+#else
+	return false;
+#endif
+}
+
+size_t CycleCollector::tracked() {
+	pthread_mutex_lock(&_registryMutex);
+	size_t result = _registry != nullptr ? _registry->objects.size() : 0;
+	pthread_mutex_unlock(&_registryMutex);
+	return result;
+}
+
+CycleCollector::Report CycleCollector::step(
+	const Duration& budget
+) {
+	pthread_mutex_lock(&_collectorMutex);
+	Report result = _step(budget.seconds());
+	pthread_mutex_unlock(&_collectorMutex);
+	return result;
+}
+
+CycleCollector::Report CycleCollector::collect() {
+
+	pthread_mutex_lock(&_collectorMutex);
+
+	if (_state != nullptr) {
+		_abandon(*_state);
+		_state->phase = Phase::idle;
+		_state->seen.clear();
+	}
+
+	pthread_mutex_lock(&_registryMutex);
+	if (_registry != nullptr) _registry->cursor = 0;
+	pthread_mutex_unlock(&_registryMutex);
+
+	Report result = _step(INFINITY);
+
+	pthread_mutex_unlock(&_collectorMutex);
+
+	return result;
+
+}
+
+void CycleCollector::track(
+	const Object* object
+) {
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+	pthread_mutex_lock(&_registryMutex);
+	if (_registry == nullptr) _registry = new Registry();
+	if (object->_trackedIndex.load(std::memory_order_relaxed) == SIZE_MAX) {
+		object->_trackedIndex.store(_registry->objects.size(), std::memory_order_relaxed);
+		_registry->objects.push_back(object);
+	}
+	pthread_mutex_unlock(&_registryMutex);
+#else
+	(void)object;
+#endif
+}
+
+void CycleCollector::untrack(
+	const Object* object
+) {
+
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+
+	pthread_mutex_lock(&_registryMutex);
+
+	size_t index = object->_trackedIndex.load(std::memory_order_relaxed);
+
+	if (index != SIZE_MAX) {
+
+		// Keep objects that have not been examined in this pass at or after
+		// the cursor.
+		if (index < _registry->cursor) {
+			const Object* examined = _registry->objects[--_registry->cursor];
+			_registry->objects[index] = examined;
+			examined->_trackedIndex.store(index, std::memory_order_relaxed);
+			index = _registry->cursor;
+		}
+
+		if (index != _registry->objects.size() - 1) {
+			const Object* last = _registry->objects.back();
+			_registry->objects[index] = last;
+			last->_trackedIndex.store(index, std::memory_order_relaxed);
+		}
+
+		_registry->objects.pop_back();
+		object->_trackedIndex.store(SIZE_MAX, std::memory_order_relaxed);
+
+	}
+
+	pthread_mutex_unlock(&_registryMutex);
+
+#else
+	(void)object;
+#endif
+
+}
+
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+// Containers are only locked by the collector for the duration of a single
+// read, so waiting is short.
+void CycleCollector::Lock::_wait() const {
+	for (size_t spins = 1 ; this->_locked.exchange(true, std::memory_order_acquire) ; spins++) {
+		if (spins % _spinsBeforeYield == 0) sched_yield();
+		else _pause();
+	}
+}
+#endif
@@ -0,0 +1,121 @@
+//
+// cycle-collector.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_cycle_collector_hpp
+#define foundation_cycle_collector_hpp
+
+#include <stddef.h>
+#include <atomic>
+
+namespace foundation::types {
+	class Duration;
+}
+
+namespace foundation::memory {
+
+	class Object;
+
+	// Trial deletion cycle collector.
+	//
+	// When the library is built with `FOUNDATION_MEMORY_CYCLE_COLLECTOR`,
+	// containers (`Array` and `Dictionary`) are tracked once they are stored in
+	// another container – only those can be part of a cycle – and until they are
+	// destroyed. Each `step` examines tracked containers one at a time, and for each one
+	// subtracts the references held inside its object graph from the retain
+	// counts. Objects left with no outside references are garbage – the cycles
+	// are broken by emptying their containers.
+	//
+	// Steps work one object at a time and stop as soon as their budget is spent
+	// – also in the middle of a graph – and the next step continues where the
+	// previous one stopped. Objects being examined are retained by the collector
+	// between steps. Containers are locked while they are read, so other threads
+	// may change them at any time – if a graph changes while it is examined,
+	// nothing is collected from it until it is examined again.
+	class CycleCollector {
+
+	public:
+
+		// Held by containers while they change the objects they retain, and by the
+		// collector while it reads them. Does nothing unless the library is built
+		// with the cycle collector.
+		class Lock {
+
+		public:
+
+			class Guard {
+
+			public:
+
+				Guard(const Lock& lock) : _lock(lock) {
+					_lock.lock();
+				}
+
+				~Guard() {
+					_lock.unlock();
+				}
+
+			private:
+
+				const Lock& _lock;
+
+			};
+
+			Lock() = default;
+			Lock(const Lock&) = delete;
+
+			Lock& operator=(const Lock&) = delete;
+
+			inline void lock() const {
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+				if (this->_locked.exchange(true, std::memory_order_acquire)) this->_wait();
+#endif
+			}
+
+			inline void unlock() const {
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+				this->_locked.store(false, std::memory_order_release);
+#endif
+			}
+
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+		private:
+
+			mutable std::atomic<bool> _locked = false;
+
+			void _wait() const;
+#endif
+
+		};
+
+		struct Report {
+			size_t examined;
+			size_t collected;
+			size_t cycles;
+			bool completed;
+		};
+
+		static bool isEnabled();
+
+		static size_t tracked();
+
+		static Report step(
+			const types::Duration& budget);
+
+		static Report collect();
+
+		static void track(
+			const Object* object);
+
+		static void untrack(
+			const Object* object);
+
+	};
+
+}
+
+#endif /* foundation_cycle_collector_hpp */
@@ -9,7 +9,12 @@
 #ifndef foundation_memory_hpp
 #define foundation_memory_hpp
 
+#include "./arena.hpp"
+#include "./autorelease-pool.hpp"
+#include "./counting.hpp"
+#include "./cycle-collector.hpp"
 #include "./object.hpp"
+#include "./statistics.hpp"
 #include "./strong.hpp"
 #include "./weak.hpp"
 
@@ -7,6 +7,11 @@
 //
 
 #include <assert.h>
+#include <sched.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
 
 #include "../exceptions/exceptions.hpp"
 #include "./weak.hpp"
@@ -16,34 +21,71 @@
 using namespace foundation::memory;
 using namespace foundation::exceptions::memory;
 
-void Object::addWeakReference(
-	void* weakReference
-) const {
-	if (_weakReferencesSize < _weakReferencesCount + 1) {
-		_weakReferencesSize = Allocator::calculateBufferLength(_weakReferencesCount + 1);
-		_weakReferences = (void**)realloc(_weakReferences, _weakReferencesSize);
-		_weakReferences[_weakReferencesCount++] = weakReference;
-	}
+static const size_t _spinsBeforeYield = 256;
+
+static inline void _pause() {
+#if defined(__x86_64__) || defined(__i386__)
+	_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#endif
 }
 
-void Object::removeWeakReference(
-	void* weakReference
+Object::Control* Object::_retainControl(
 ) const {
-	for (size_t idx = 0 ; idx < _weakReferencesCount ; idx++) {
-		if (_weakReferences[idx] == weakReference) {
-			for (size_t midx = idx ; midx <= _weakReferencesCount - 1 ; midx++) {
-				_weakReferences[midx] = _weakReferences[midx + 1];
-			}
-			_weakReferencesCount--;
+
+	Control* control = this->_control.load(std::memory_order_acquire);
+
+	if (control == nullptr) {
+		Control* created = new Control { this, 1, 0 };
+		if (this->_control.compare_exchange_strong(control, created, std::memory_order_acq_rel)) {
+			control = created;
+		} else {
+			delete created;
 		}
 	}
+
+	control->references.fetch_add(1, std::memory_order_relaxed);
+
+	return control;
+
+}
+
+void Object::_releaseControl(
+	Control* control
+) {
+	if (control->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		delete control;
+	}
+}
+
+const Object* Object::_lockControl(
+	Control* control
+) {
+
+	// The object cannot be freed while a locker is registered, because the
+	// destructor waits for lockers to finish after expiring the block.
+	control->lockers++;
+
+	const Object* object = control->object.load();
+
+	if (object != nullptr && !object->retainIfAlive()) {
+		object = nullptr;
+	}
+
+	control->lockers.fetch_sub(1, std::memory_order_release);
+
+	return object;
+
 }
 
 Object::Object(
 ) : _retainCount(0),
-	_weakReferences(nullptr),
-	_weakReferencesSize(0),
-	_weakReferencesCount(0) { }
+	_control(nullptr)
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+	, _trackedIndex(SIZE_MAX)
+#endif
+{ }
 
 Object::Object(
 	const Object&
@@ -56,11 +98,20 @@ Object::Object(
 Object::~Object(
 ) {
 	assert(_retainCount == 0);
-	for (size_t idx = 0 ; idx < _weakReferencesCount ; idx++) {
-		((Weak<Object>*)_weakReferences[idx])->_object = nullptr;
-	}
-	if (_weakReferences != nullptr) {
-		free(_weakReferences);
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+	if (this->_trackedIndex.load(std::memory_order_relaxed) != SIZE_MAX) CycleCollector::untrack(this);
+#endif
+	Control* control = this->_control.load(std::memory_order_acquire);
+	if (control != nullptr) {
+		control->object.store(nullptr);
+		// Lockers that registered before the store above are seen by the loads
+		// below, and later ones see the block expired.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		for (size_t spins = 1 ; control->lockers.load(std::memory_order_acquire) != 0 ; spins++) {
+			if (spins % _spinsBeforeYield == 0) sched_yield();
+			else _pause();
+		}
+		_releaseControl(control);
 	}
 }
 
@@ -78,15 +129,40 @@ Object& Object::operator=(
 
 void Object::retain(
 ) const {
-	this->_retainCount++;
+	this->retain<CountingPolicy<Object>::value>();
 }
 
 void Object::release(
 ) const {
-	if (--this->_retainCount == 0) delete this;
+	this->release<CountingPolicy<Object>::value>();
+}
+
+bool Object::retainIfAlive(
+) const {
+	size_t count = this->_retainCount.load();
+	while (count > 0 && !this->_retainCount.compare_exchange_weak(count, count + 1)) { }
+	return count > 0;
 }
 
 size_t Object::retainCount(
 ) const {
-	return this->_retainCount;
+	return Counter<CountingPolicy<Object>::value>::load(this->_retainCount);
 }
+
+bool Object::isCollectable(
+) const {
+	return false;
+}
+
+size_t Object::retainedCount(
+) const {
+	return 0;
+}
+
+const Object* Object::lockRetainedAt(
+	size_t
+) const {
+	return nullptr;
+}
+
+void Object::releaseRetained() { }
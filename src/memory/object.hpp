@@ -9,10 +9,14 @@
 #ifndef foundation_object_hpp
 #define foundation_object_hpp
 
+#include <stdint.h>
 #include <unistd.h>
 #include <atomic>
 
 #include "./allocator.hpp"
+#include "./counting.hpp"
+#include "./cycle-collector.hpp"
+#include "./statistics.hpp"
 
 namespace foundation::memory {
 
@@ -24,16 +28,33 @@ namespace foundation::memory {
 		template<typename T>
 		friend class Weak;
 
+		friend class CycleCollector;
+
 	private:
 
+		// Side-allocated block shared by all weak references to an object. It
+		// outlives the object until the last weak reference is gone.
+		struct Control {
+			std::atomic<const Object*> object;
+			std::atomic<size_t> references;
+			std::atomic<size_t> lockers;
+		};
+
 		mutable std::atomic<size_t> _retainCount;
-		mutable void** _weakReferences;
-		mutable size_t _weakReferencesSize;
-		mutable size_t _weakReferencesCount;
+		mutable std::atomic<Control*> _control;
+
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+		// Position in the cycle collector's registry – `SIZE_MAX` when untracked.
+		mutable std::atomic<size_t> _trackedIndex;
+#endif
 
-		void addWeakReference(void* weakReference) const;
+		Control* _retainControl() const;
 
-		void removeWeakReference(void* weakReference) const;
+		static void _releaseControl(
+			Control* control);
+
+		static const Object* _lockControl(
+			Control* control);
 
 	public:
 
@@ -58,8 +79,58 @@ namespace foundation::memory {
 		void retain() const;
 		void release() const;
 
+		template<Counting C>
+		inline void retain() const {
+			if (Counter<C>::increment(this->_retainCount) == 0) {
+#ifdef FOUNDATION_MEMORY_STATISTICS
+				Statistics::retained(this);
+#endif
+			}
+		}
+
+		template<Counting C>
+		inline void release() const {
+			if (Counter<C>::decrement(this->_retainCount) == 0) {
+#ifdef FOUNDATION_MEMORY_STATISTICS
+				Statistics::released(this);
+#endif
+				delete this;
+			}
+		}
+
+		// Retains the object unless its retain count has already reached zero.
+		bool retainIfAlive() const;
+
 		size_t retainCount() const;
 
+		template<Counting C>
+		inline size_t retainCount() const {
+			return Counter<C>::load(this->_retainCount);
+		}
+
+		// Cycle collection support. Containers return true from `isCollectable`,
+		// call `stored` on every object they retain, expose those objects through
+		// `retainedCount` and `lockRetainedAt`, and release all of them in
+		// `releaseRetained`. `lockRetainedAt` returns the object retained for the
+		// caller, or nullptr if the container no longer holds that many.
+		virtual bool isCollectable() const;
+
+		inline void stored() const {
+#ifdef FOUNDATION_MEMORY_CYCLE_COLLECTOR
+			if (this->_trackedIndex.load(std::memory_order_relaxed) == SIZE_MAX && this->isCollectable()) {
+				CycleCollector::track(this);
+			}
+#endif
+		}
+
+		virtual size_t retainedCount() const;
+
+		virtual const Object* lockRetainedAt(
+			size_t index
+		) const;
+
+		virtual void releaseRetained();
+
 	};
 
 }
@@ -0,0 +1,291 @@
+//
+// pool.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifdef FOUNDATION_MEMORY_POOL
+
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "../exceptions/exception.hpp"
+
+#include "./pool.hpp"
+
+using namespace foundation::memory;
+using namespace foundation::exceptions::memory;
+
+namespace {
+
+	static const size_t _sizes[FOUNDATION_POOL_SIZE_CLASSES] = {
+		16, 32, 48, 64, 80, 96, 112, 128,
+		160, 192, 224, 256, 320, 384, 448, 512
+	};
+
+	struct Magazine {
+		Magazine* next;
+		size_t count;
+		void* items[FOUNDATION_POOL_MAGAZINE_SIZE];
+	};
+
+	struct Block {
+		Block* next;
+	};
+
+	struct Depot {
+		pthread_mutex_t mutex;
+		Magazine* full;
+		Magazine* empty;
+		Block* loose;
+		uint8_t* slab;
+		uint8_t* slabEnd;
+	};
+
+	static Depot _depots[FOUNDATION_POOL_SIZE_CLASSES] = {
+#define DEPOT { PTHREAD_MUTEX_INITIALIZER, nullptr, nullptr, nullptr, nullptr, nullptr }
+		DEPOT, DEPOT, DEPOT, DEPOT, DEPOT, DEPOT, DEPOT, DEPOT,
+		DEPOT, DEPOT, DEPOT, DEPOT, DEPOT, DEPOT, DEPOT, DEPOT
+#undef DEPOT
+	};
+
+	static Magazine* _newMagazine(
+		Depot& depot
+	) noexcept(false) {
+		Magazine* magazine = depot.empty;
+		if (magazine != nullptr) {
+			depot.empty = magazine->next;
+		} else {
+			magazine = (Magazine*)malloc(sizeof(Magazine));
+			if (!magazine) throw AllocationException(sizeof(Magazine));
+		}
+		magazine->next = nullptr;
+		magazine->count = 0;
+		return magazine;
+	}
+
+	static void* _take(
+		Depot& depot,
+		size_t size
+	) noexcept(false) {
+		if (depot.loose != nullptr) {
+			Block* block = depot.loose;
+			depot.loose = block->next;
+			return block;
+		}
+		if (depot.slab == nullptr || depot.slab + size > depot.slabEnd) {
+			depot.slab = (uint8_t*)malloc(FOUNDATION_POOL_SLAB_SIZE);
+			if (!depot.slab) throw AllocationException(FOUNDATION_POOL_SLAB_SIZE);
+			depot.slabEnd = depot.slab + FOUNDATION_POOL_SLAB_SIZE;
+		}
+		void* mem = depot.slab;
+		depot.slab += size;
+		return mem;
+	}
+
+	static void _fill(
+		Depot& depot,
+		Magazine* magazine,
+		size_t size
+	) noexcept(false) {
+		do {
+			magazine->items[magazine->count++] = _take(depot, size);
+		} while (magazine->count < FOUNDATION_POOL_MAGAZINE_SIZE && (depot.loose != nullptr || depot.slab + size <= depot.slabEnd));
+	}
+
+	class Cache {
+
+	public:
+
+		~Cache() {
+			for (size_t idx = 0 ; idx < FOUNDATION_POOL_SIZE_CLASSES ; idx++) {
+				Magazine* magazine = this->_magazines[idx];
+				if (magazine == nullptr) continue;
+				Depot& depot = _depots[idx];
+				pthread_mutex_lock(&depot.mutex);
+				if (magazine->count > 0) {
+					magazine->next = depot.full;
+					depot.full = magazine;
+				} else {
+					magazine->next = depot.empty;
+					depot.empty = magazine;
+				}
+				pthread_mutex_unlock(&depot.mutex);
+				this->_magazines[idx] = nullptr;
+			}
+			_destroyed = true;
+		}
+
+		static bool destroyed() {
+			return _destroyed;
+		}
+
+		void* pop(
+			size_t sizeClass
+		) noexcept(false) {
+
+			Magazine* magazine = this->_magazines[sizeClass];
+
+			if (magazine == nullptr || magazine->count == 0) {
+
+				Depot& depot = _depots[sizeClass];
+
+				pthread_mutex_lock(&depot.mutex);
+
+				try {
+					if (magazine == nullptr) {
+						magazine = _newMagazine(depot);
+					}
+					if (depot.full != nullptr) {
+						Magazine* full = depot.full;
+						depot.full = full->next;
+						magazine->next = depot.empty;
+						depot.empty = magazine;
+						magazine = full;
+					} else {
+						_fill(depot, magazine, _sizes[sizeClass]);
+					}
+				} catch (...) {
+					pthread_mutex_unlock(&depot.mutex);
+					throw;
+				}
+
+				pthread_mutex_unlock(&depot.mutex);
+
+				this->_magazines[sizeClass] = magazine;
+
+			}
+
+			return magazine->items[--magazine->count];
+
+		}
+
+		void push(
+			void* ptr,
+			size_t sizeClass
+		) noexcept(false) {
+
+			Magazine* magazine = this->_magazines[sizeClass];
+
+			if (magazine == nullptr || magazine->count == FOUNDATION_POOL_MAGAZINE_SIZE) {
+
+				Depot& depot = _depots[sizeClass];
+
+				pthread_mutex_lock(&depot.mutex);
+
+				if (magazine != nullptr) {
+					magazine->next = depot.full;
+					depot.full = magazine;
+				}
+
+				try {
+					magazine = _newMagazine(depot);
+				} catch (...) {
+					pthread_mutex_unlock(&depot.mutex);
+					throw;
+				}
+
+				pthread_mutex_unlock(&depot.mutex);
+
+				this->_magazines[sizeClass] = magazine;
+
+			}
+
+			magazine->items[magazine->count++] = ptr;
+
+		}
+
+	private:
+
+		Magazine* _magazines[FOUNDATION_POOL_SIZE_CLASSES] = {};
+
+		static thread_local bool _destroyed;
+
+	};
+
+	thread_local bool Cache::_destroyed = false;
+
+	thread_local Cache _cache;
+
+}
+
+size_t Pool::sizeClass(
+	size_t size
+) {
+	if (size <= 128) return size == 0 ? 0 : (size - 1) / 16;
+	if (size <= 256) return 8 + (size - 129) / 32;
+	if (size <= FOUNDATION_POOL_MAXIMUM_SIZE) return 12 + (size - 257) / 64;
+	return FOUNDATION_POOL_SIZE_CLASSES;
+}
+
+size_t Pool::sizeOfClass(
+	size_t sizeClass
+) {
+	if (sizeClass >= FOUNDATION_POOL_SIZE_CLASSES) return 0;
+	return _sizes[sizeClass];
+}
+
+void* Pool::allocate(
+	size_t size
+) noexcept(false) {
+
+	size_t sizeClass = Pool::sizeClass(size);
+
+	if (sizeClass == FOUNDATION_POOL_SIZE_CLASSES) {
+		void* mem = malloc(size);
+		if (!mem) throw AllocationException(size);
+		return mem;
+	}
+
+	if (Cache::destroyed()) {
+		Depot& depot = _depots[sizeClass];
+		pthread_mutex_lock(&depot.mutex);
+		void* mem = nullptr;
+		try {
+			mem = _take(depot, _sizes[sizeClass]);
+		} catch (...) {
+			pthread_mutex_unlock(&depot.mutex);
+			throw;
+		}
+		pthread_mutex_unlock(&depot.mutex);
+		return mem;
+	}
+
+	return _cache.pop(sizeClass);
+
+}
+
+void Pool::deallocate(
+	void* ptr,
+	size_t size
+) {
+
+	if (ptr == nullptr) return;
+
+	size_t sizeClass = Pool::sizeClass(size);
+
+	if (sizeClass == FOUNDATION_POOL_SIZE_CLASSES) {
+		free(ptr);
+		return;
+	}
+
+	// Threads that have already torn down their cache hand blocks straight
+	// back to the depot.
+	if (!Cache::destroyed()) {
+		try {
+			_cache.push(ptr, sizeClass);
+			return;
+		} catch (...) { }
+	}
+
+	Depot& depot = _depots[sizeClass];
+	pthread_mutex_lock(&depot.mutex);
+	((Block*)ptr)->next = depot.loose;
+	depot.loose = (Block*)ptr;
+	pthread_mutex_unlock(&depot.mutex);
+
+}
+
+#endif /* FOUNDATION_MEMORY_POOL */
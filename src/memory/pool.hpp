@@ -0,0 +1,50 @@
+//
+// pool.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_pool_hpp
+#define foundation_pool_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FOUNDATION_POOL_SIZE_CLASSES 16
+#define FOUNDATION_POOL_MAXIMUM_SIZE 512
+#define FOUNDATION_POOL_MAGAZINE_SIZE 64
+#define FOUNDATION_POOL_SLAB_SIZE 65536
+
+namespace foundation::memory {
+
+	// Size-class slab allocator.
+	//
+	// Every thread keeps one magazine (a small stack of free blocks) per size
+	// class. Magazines are exchanged with a global depot when they run full or
+	// empty, and the depot carves new blocks from slabs when it is out of
+	// magazines. Slabs are never returned to the system.
+	class Pool {
+
+	public:
+
+		static size_t sizeClass(
+			size_t size);
+
+		static size_t sizeOfClass(
+			size_t sizeClass);
+
+		static void* allocate(
+			size_t size
+		) noexcept(false);
+
+		static void deallocate(
+			void* ptr,
+			size_t size);
+
+	};
+
+}
+
+#endif /* foundation_pool_hpp */
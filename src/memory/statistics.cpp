@@ -0,0 +1,138 @@
+//
+// statistics.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <atomic>
+
+#include "../types/type.hpp"
+
+#include "./statistics.hpp"
+
+using namespace foundation::memory;
+using namespace foundation::types;
+
+static std::atomic<size_t> _liveBytes(0);
+static std::atomic<size_t> _peakBytes(0);
+static std::atomic<size_t> _storageBytes(0);
+static std::atomic<size_t> _allocations[FOUNDATION_STATISTICS_SIZE_CLASSES];
+static std::atomic<size_t> _instances[FOUNDATION_STATISTICS_KINDS];
+
+static void _grow(
+	size_t size
+) {
+	size_t live = _liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	size_t peak = _peakBytes.load(std::memory_order_relaxed);
+	while (live > peak && !_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) { }
+}
+
+static inline void _shrink(
+	size_t size
+) {
+	_liveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+static inline std::atomic<size_t>* _instancesOf(
+	const Object* object
+) {
+	const Type* type = dynamic_cast<const Type*>(object);
+	if (type == nullptr) return nullptr;
+	size_t kind = (size_t)type->kind();
+	if (kind >= FOUNDATION_STATISTICS_KINDS) return nullptr;
+	return &_instances[kind];
+}
+
+bool Statistics::isEnabled() {
+#ifdef FOUNDATION_MEMORY_STATISTICS
+	return true;
+#else
+	return false;
+#endif
+}
+
+Statistics::Snapshot Statistics::snapshot() {
+
+	Snapshot result;
+
+	result.liveBytes = _liveBytes.load(std::memory_order_relaxed);
+	result.peakBytes = _peakBytes.load(std::memory_order_relaxed);
+	result.storageBytes = _storageBytes.load(std::memory_order_relaxed);
+
+	for (size_t idx = 0 ; idx < FOUNDATION_STATISTICS_SIZE_CLASSES ; idx++) {
+		result.allocations[idx] = _allocations[idx].load(std::memory_order_relaxed);
+	}
+
+	for (size_t idx = 0 ; idx < FOUNDATION_STATISTICS_KINDS ; idx++) {
+		result.instances[idx] = _instances[idx].load(std::memory_order_relaxed);
+	}
+
+	return result;
+
+}
+
+void Statistics::reset() {
+	_peakBytes.store(_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	for (size_t idx = 0 ; idx < FOUNDATION_STATISTICS_SIZE_CLASSES ; idx++) {
+		_allocations[idx].store(0, std::memory_order_relaxed);
+	}
+}
+
+size_t Statistics::sizeClass(
+	size_t size
+) {
+	if (size <= 16) return 0;
+	size_t result = (64 - __builtin_clzll((unsigned long long)size - 1)) - 4;
+	if (result > FOUNDATION_STATISTICS_SIZE_CLASSES - 1) return FOUNDATION_STATISTICS_SIZE_CLASSES - 1;
+	return result;
+}
+
+size_t Statistics::sizeOfClass(
+	size_t sizeClass
+) {
+	if (sizeClass >= FOUNDATION_STATISTICS_SIZE_CLASSES - 1) return 0;
+	return (size_t)16 << sizeClass;
+}
+
+void Statistics::allocated(
+	size_t size
+) {
+	_allocations[Statistics::sizeClass(size)].fetch_add(1, std::memory_order_relaxed);
+	_grow(size);
+}
+
+void Statistics::deallocated(
+	size_t size
+) {
+	_shrink(size);
+}
+
+void Statistics::storageResized(
+	size_t oldSize,
+	size_t newSize
+) {
+	if (newSize > oldSize) {
+		_storageBytes.fetch_add(newSize - oldSize, std::memory_order_relaxed);
+		_allocations[Statistics::sizeClass(newSize)].fetch_add(1, std::memory_order_relaxed);
+		_grow(newSize - oldSize);
+	} else if (oldSize > newSize) {
+		_storageBytes.fetch_sub(oldSize - newSize, std::memory_order_relaxed);
+		_shrink(oldSize - newSize);
+	}
+}
+
+void Statistics::retained(
+	const Object* object
+) {
+	std::atomic<size_t>* instances = _instancesOf(object);
+	if (instances != nullptr) instances->fetch_add(1, std::memory_order_relaxed);
+}
+
+void Statistics::released(
+	const Object* object
+) {
+	std::atomic<size_t>* instances = _instancesOf(object);
+	if (instances != nullptr) instances->fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,68 @@
+//
+// statistics.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_statistics_hpp
+#define foundation_statistics_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FOUNDATION_STATISTICS_SIZE_CLASSES 18
+#define FOUNDATION_STATISTICS_KINDS 16
+
+namespace foundation::memory {
+
+	class Object;
+
+	// Allocation accounting. Counters are only updated when the library is
+	// built with `FOUNDATION_MEMORY_STATISTICS` – otherwise snapshots are empty.
+	class Statistics {
+
+	public:
+
+		struct Snapshot {
+			size_t liveBytes;
+			size_t peakBytes;
+			size_t storageBytes;
+			size_t allocations[FOUNDATION_STATISTICS_SIZE_CLASSES];
+			size_t instances[FOUNDATION_STATISTICS_KINDS];
+		};
+
+		static bool isEnabled();
+
+		static Snapshot snapshot();
+
+		static void reset();
+
+		static size_t sizeClass(
+			size_t size);
+
+		static size_t sizeOfClass(
+			size_t sizeClass);
+
+		static void allocated(
+			size_t size);
+
+		static void deallocated(
+			size_t size);
+
+		static void storageResized(
+			size_t oldSize,
+			size_t newSize);
+
+		static void retained(
+			const Object* object);
+
+		static void released(
+			const Object* object);
+
+	};
+
+}
+
+#endif /* foundation_statistics_hpp */
@@ -11,10 +11,12 @@
 
 #include <assert.h>
 
+#include <atomic>
 #include <type_traits>
 #include <functional>
 
 #include "./allocator.hpp"
+#include "./autorelease-pool.hpp"
 #include "./object.hpp"
 
 using namespace std;
@@ -32,15 +34,35 @@ namespace foundation::memory {
 	private:
 
 		T* _object;
+		bool _isAutoreleased;
+
+#ifdef DEBUG
+		static inline std::atomic<size_t> _implicitCopies = 0;
+#endif
+
+		static inline void _copied() {
+#ifdef DEBUG
+			_implicitCopies.fetch_add(1, std::memory_order_relaxed);
+#endif
+		}
+
+		static void _release(const Object* object) {
+			object->template release<CountingPolicy<T>::value>();
+		}
 
 		void _setObject(T* object, bool newObject = false) {
 
 			T* oldObject = _object;
+			bool isAutoreleased = _isAutoreleased;
+
+			_object = nullptr;
+			_isAutoreleased = false;
 
 			if (object) {
 				// If object is allocated on the stack, we make a copy on the heap.
-				if (!newObject && object->retainCount() == 0) {
+				if (!newObject && object->template retainCount<CountingPolicy<T>::value>() == 0) {
 					if constexpr (is_copy_constructible<T>::value) {
+						_copied();
 						_object = new T(*object);
 					} else {
 						assert(false);
@@ -48,11 +70,11 @@ namespace foundation::memory {
 				} else {
 					_object = object;
 				}
-				_object->retain();
+				_object->template retain<CountingPolicy<T>::value>();
 			}
 
-			if (oldObject != nullptr) {
-				oldObject->release();
+			if (oldObject != nullptr && !(isAutoreleased && AutoreleasePool::defer(oldObject, _release))) {
+				_release(oldObject);
 				oldObject = nullptr;
 			}
 
@@ -60,40 +82,51 @@ namespace foundation::memory {
 
 	public:
 
-		Strong(nullptr_t) : _object(nullptr) {};
+		Strong(nullptr_t) : _object(nullptr), _isAutoreleased(false) {};
 		Strong(T& object) : Strong(&object) {};
 
 		Strong(const T& object) : Strong(nullptr) {
 			if constexpr (is_copy_constructible<T>::value) {
+				_copied();
 				_setObject(new T(object), true);
 			} else {
 				_setObject(&(T&)object);
 			}
 		}
 
-		Strong(T* object) : _object(nullptr) {
+		Strong(T&& object) : Strong(nullptr) {
+			if constexpr (is_move_constructible<T>::value) {
+				_copied();
+				_setObject(new T(std::move(object)), true);
+			} else {
+				_setObject(&object);
+			}
+		}
+
+		Strong(T* object) : _object(nullptr), _isAutoreleased(false) {
 			_setObject(object);
 		}
 
-		explicit Strong(const T* object) : _object(nullptr) {
+		explicit Strong(const T* object) : _object(nullptr), _isAutoreleased(false) {
 			_setObject((T*)object);
 		}
 
-		Strong(const Strong<T>& other) : _object(nullptr) {
+		Strong(const Strong<T>& other) : _object(nullptr), _isAutoreleased(false) {
 			_setObject(other._object);
 		}
 
 		Strong(Strong<T>&& other) {
 			this->_object = other._object;
+			this->_isAutoreleased = other._isAutoreleased;
 			other._object = nullptr;
+			other._isAutoreleased = false;
 		}
 
-		Strong(const Weak<T>& other) : _object(nullptr) {
-			_setObject(other);
-		}
+		Strong(const Weak<T>& other) : _object(other._lock()), _isAutoreleased(false) { }
+		Strong(Weak<T>& other) : Strong((const Weak<T>&)other) { }
 
 		template<typename... Args>
-		explicit Strong(Args&&... args) : _object(nullptr) {
+		explicit Strong(Args&&... args) : _object(nullptr), _isAutoreleased(false) {
 			_setObject(new T(std::forward<Args>(args)...), true);
 		}
 
@@ -101,6 +134,32 @@ namespace foundation::memory {
 			_setObject(nullptr);
 		}
 
+		// Constructs the object directly on the heap.
+		template<typename... Args>
+		static Strong<T> make(Args&&... args) {
+			Strong<T> result(nullptr);
+			result._setObject(new T(std::forward<Args>(args)...), true);
+			return result;
+		}
+
+		// Takes ownership of a heap allocated object that has not been retained
+		// yet, without copying it.
+		static Strong<T> adopt(T* object) {
+			Strong<T> result(nullptr);
+			result._setObject(object, true);
+			return result;
+		}
+
+		// Number of times an unretained object of this type was copied or moved
+		// to the heap implicitly. Only counted in DEBUG builds.
+		static size_t implicitCopies() {
+#ifdef DEBUG
+			return _implicitCopies.load(std::memory_order_relaxed);
+#else
+			return 0;
+#endif
+		}
+
 		operator T&() const {
 			return *_object;
 		}
@@ -119,9 +178,8 @@ namespace foundation::memory {
 			return *this;
 		}
 
-		Strong<T>& operator =(Weak<T> object) {
-			_setObject(object);
-			return *this;
+		Strong<T>& operator =(const Weak<T>& object) {
+			return *this = Strong<T>(object);
 		}
 
 		Strong<T>& operator =(const Strong<T>& object) {
@@ -132,7 +190,9 @@ namespace foundation::memory {
 		Strong<T>& operator =(Strong<T>&& other) {
 			this->_setObject(nullptr);
 			this->_object = other._object;
+			this->_isAutoreleased = other._isAutoreleased;
 			other._object = nullptr;
+			other._isAutoreleased = false;
 			return *this;
 		}
 
@@ -178,6 +238,21 @@ namespace foundation::memory {
 			return Strong<T>(this->_object);
 		}
 
+		// Marks the reference as a temporary. When it is released while an
+		// `AutoreleasePool` is current, the release is deferred to the pool
+		// instead of happening immediately. Moves keep the mark, copies do not.
+		Strong<T> autoreleased() const & {
+			Strong<T> result(*this);
+			result._isAutoreleased = true;
+			return result;
+		}
+
+		Strong<T> autoreleased() && {
+			Strong<T> result(std::move(*this));
+			result._isAutoreleased = true;
+			return result;
+		}
+
 		Object* object() const {
 			return this->_object;
 		}
@@ -13,6 +13,7 @@
 #include <atomic>
 
 #include "./allocator.hpp"
+#include "./object.hpp"
 
 namespace foundation::memory {
 
@@ -29,51 +30,76 @@ namespace foundation::memory {
 
 		friend class Object;
 
+		template<typename O>
+		friend class Strong;
+
 	private:
-		std::atomic<T*> _object;
+		Object::Control* _control;
 
 		void _setObject(T* object) {
-			if (_object != nullptr) {
-				_object.load()->removeWeakReference(this);
+			Object::Control* oldControl = _control;
+			_control = object != nullptr ? object->_retainControl() : nullptr;
+			if (oldControl != nullptr) {
+				Object::_releaseControl(oldControl);
+			}
+		}
+
+		void _setControl(Object::Control* control) {
+			if (control != nullptr) {
+				control->references.fetch_add(1, std::memory_order_relaxed);
 			}
-			_object = object;
-			if (_object) {
-				_object.load()->addWeakReference(this);
+			Object::Control* oldControl = _control;
+			_control = control;
+			if (oldControl != nullptr) {
+				Object::_releaseControl(oldControl);
 			}
 		}
 
+		T* _object() const {
+			if (_control == nullptr) return nullptr;
+			return (T*)_control->object.load(std::memory_order_acquire);
+		}
+
+		// Returns the object retained, or `nullptr` if it has been released.
+		T* _lock() const {
+			if (_control == nullptr) return nullptr;
+			return (T*)Object::_lockControl(_control);
+		}
+
 	public:
 		Weak() : Weak(nullptr) {}
 		Weak(T& object) : Weak(&object) {}
 
-		Weak(T* object) : _object(nullptr) {
+		Weak(T* object) : _control(nullptr) {
 			_setObject(object);
 		}
 
-		Weak(std::nullptr_t) : _object(nullptr) {
-			_setObject(nullptr);
-		}
+		Weak(std::nullptr_t) : _control(nullptr) {}
 
 		Weak(const Strong<T>& other) : Weak(*other) {}
 
-		Weak(Weak<T>&& other) : _object(other._object) {
-			other._object = nullptr;
+		Weak(const Weak<T>& other) : _control(nullptr) {
+			_setControl(other._control);
+		}
+
+		Weak(Weak<T>&& other) : _control(other._control) {
+			other._control = nullptr;
 		}
 
 		~Weak() {
-			_setObject(nullptr);
+			_setControl(nullptr);
 		}
 
 		bool isNull() const {
-			return _object == nullptr;
+			return _object() == nullptr;
 		}
 
 		operator T&() const {
-			return *_object;
+			return *_object();
 		}
 
 		operator T*() const {
-			return _object;
+			return _object();
 		}
 
 		Weak<T>& operator =(T& object) {
@@ -81,36 +107,44 @@ namespace foundation::memory {
 			return *this;
 		}
 
-		Weak<T>& operator =(T&& other) {
-			_setObject(other._object);
-			other._setObject(nullptr);
+		Weak<T>& operator =(T* object) {
+			_setObject(object);
 			return *this;
 		}
 
-		Weak<T>& operator =(T* object) {
+		Weak<T>& operator =(const Strong<T>& object) {
 			_setObject(object);
 			return *this;
 		}
 
-		Weak<T>& operator =(Strong<T> object) {
-			_setObject(object);
+		Weak<T>& operator =(const Weak<T>& other) {
+			if (this != &other) _setControl(other._control);
+			return *this;
+		}
+
+		Weak<T>& operator =(Weak<T>&& other) {
+			if (this != &other) {
+				_setControl(nullptr);
+				_control = other._control;
+				other._control = nullptr;
+			}
 			return *this;
 		}
 
 		T* operator ->() const {
-			return _object;
+			return _object();
 		}
 
 		bool operator==(std::nullptr_t) const = delete;
 		bool operator!=(std::nullptr_t) const  = delete;
 
 		bool equals(std::nullptr_t) const {
-			return this->_object == nullptr;
+			return this->isNull();
 		}
 
 		template<typename O>
 		Weak<O> as() const {
-			return Weak<O>((O*)_object.load());
+			return Weak<O>((O*)_object());
 		}
 
 	};
@@ -0,0 +1,101 @@
+//
+// parallel.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <unistd.h>
+
+#include <atomic>
+#include <exception>
+
+#include "../tools/math.hpp"
+#include "../types/array.hpp"
+#include "./mutex.hpp"
+#include "./thread.hpp"
+
+#include "./parallel.hpp"
+
+using namespace foundation::parallelism;
+using namespace foundation::tools;
+using namespace foundation::types;
+
+static std::atomic<size_t> _concurrency(0);
+
+size_t Parallel::concurrency() {
+	size_t result = _concurrency.load(std::memory_order_relaxed);
+	if (result > 0) return result;
+	return (size_t)math::max<long>(1, sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+void Parallel::setConcurrency(
+	size_t concurrency
+) {
+	_concurrency.store(concurrency, std::memory_order_relaxed);
+}
+
+size_t Parallel::partitions(
+	size_t length,
+	size_t grain
+) {
+	grain = math::max<size_t>(1, grain);
+	return length / grain + (length % grain > 0 ? 1 : 0);
+}
+
+void Parallel::forEachPartition(
+	size_t length,
+	size_t grain,
+	const std::function<void(size_t partition, size_t start, size_t end)>& todo
+) noexcept(false) {
+
+	grain = math::max<size_t>(1, grain);
+
+	size_t partitions = Parallel::partitions(length, grain);
+
+	if (partitions == 0) return;
+	if (partitions == 1) return todo(0, 0, length);
+
+	std::atomic<size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::exception_ptr exception = nullptr;
+	Mutex mutex;
+
+	auto work = [&]() {
+		while (!failed.load(std::memory_order_relaxed)) {
+			size_t partition = next.fetch_add(1, std::memory_order_relaxed);
+			if (partition >= partitions) break;
+			try {
+				todo(partition, partition * grain, math::min(length, (partition + 1) * grain));
+			} catch (...) {
+				mutex.locked([&]() {
+					if (exception == nullptr) exception = std::current_exception();
+				});
+				failed = true;
+			}
+		}
+	};
+
+	{
+
+		Array<Thread> threads;
+
+		size_t workers = math::min(Parallel::concurrency(), partitions);
+
+		for (size_t idx = 1 ; idx < workers ; idx++) {
+			threads.append(Strong<Thread>(String("parallel"), work));
+		}
+
+		work();
+
+		// Joined explicitly, as `todo` and `work` live on this stack.
+		threads.forEach([](Thread& thread) {
+			thread.join();
+		});
+
+	}
+
+	if (exception != nullptr) std::rethrow_exception(exception);
+
+}
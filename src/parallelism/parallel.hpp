@@ -0,0 +1,50 @@
+//
+// parallel.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_parallelism_parallel_hpp
+#define foundation_parallelism_parallel_hpp
+
+#include <stddef.h>
+
+#include <functional>
+
+#define FOUNDATION_PARALLEL_GRAIN_SIZE 32768
+
+namespace foundation::parallelism {
+
+	class Parallel {
+
+		public:
+
+			// The number of threads work is spread across, which defaults to the
+			// number of online processors. Setting it to zero restores the default.
+			static size_t concurrency();
+
+			static void setConcurrency(
+				size_t concurrency);
+
+			static size_t partitions(
+				size_t length,
+				size_t grain);
+
+			// Splits `[0, length)` into partitions of `grain` items and calls
+			// `todo` with the index and bounds of each. Partitions are handed out
+			// to up to `concurrency()` threads, including the calling one, and the
+			// call returns when all have completed. The first exception thrown by
+			// `todo` is rethrown, and stops partitions that have not yet started.
+			static void forEachPartition(
+				size_t length,
+				size_t grain,
+				const std::function<void(size_t partition, size_t start, size_t end)>& todo
+			) noexcept(false);
+
+	};
+
+}
+
+#endif // foundation_parallelism_parallel_hpp
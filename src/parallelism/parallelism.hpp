@@ -10,6 +10,7 @@
 #define foundation_parallelism_parallelism_hpp
 
 #include "./mutex.hpp"
+#include "./parallel.hpp"
 #include "./thread.hpp"
 
 #endif // foundation_parallelism_parallelism_hpp
@@ -34,7 +34,8 @@ Thread::Thread(
     	});
 #endif
     	function();
-    }) {
+    }),
+    _isJoined(false) {
 	
 	pthread_create(&this->_thread, nullptr, [](void* arg) -> void* {
 		auto func = static_cast<std::function<void()>*>(arg);
@@ -45,6 +46,12 @@ Thread::Thread(
 }
 
 Thread::~Thread() {
-	pthread_join(this->_thread, nullptr);
+	this->join();
 	this->_function = nullptr;
 }
+
+void Thread::join() {
+	if (this->_isJoined) return;
+	pthread_join(this->_thread, nullptr);
+	this->_isJoined = true;
+}
@@ -33,10 +33,14 @@ namespace foundation::parallelism {
 
 			virtual ~Thread();
 
+			// Waits for the thread to finish. Does nothing if already joined.
+			void join();
+
 		private:
 
 			pthread_t _thread;
 			std::function<void()> _function;
+			bool _isJoined;
 
 	};
 
@@ -22,6 +22,11 @@
 using namespace foundation::serialization;
 using namespace foundation::exceptions::serialization;
 
+// Kept at file scope so they are never lazily initialized inside an arena.
+static const String trueLiteral = "true";
+static const String falseLiteral = "false";
+static const String nullLiteral = "null";
+
 bool JSON::_hasLength(
 	const String& string,
 	size_t* idx,
@@ -305,10 +310,6 @@ Strong<Type> JSON::_parseLiteral(
 	size_t* character
 ) {
 
-	static const String trueLiteral = "true";
-	static const String falseLiteral = "false";
-	static const String nullLiteral = "null";
-
 	switch (string[*idx]) {
 		case 't':
 			this->_ensureLength(string, idx, 4, *line, *character);
@@ -432,6 +433,44 @@ Strong<String> JSON::stringify(
 
 }
 
+Strong<String> JSON::stringify(
+	const Statistics::Snapshot& snapshot
+) {
+
+	static const char* kinds[] = {
+		"data", "string", "number", "array", "dictionary",
+		"date", "pair", "uuid", "url", "null"
+	};
+
+	Strong<Dictionary<String, Type>> allocations;
+
+	for (size_t idx = 0 ; idx < FOUNDATION_STATISTICS_SIZE_CLASSES ; idx++) {
+		size_t size = Statistics::sizeOfClass(idx);
+		allocations->set(
+			Strong<String>(size > 0 ? String::format("%zu", size) : String("large")),
+			Strong<Integer>(snapshot.allocations[idx]).as<Type>());
+	}
+
+	Strong<Dictionary<String, Type>> instances;
+
+	for (size_t idx = 0 ; idx < sizeof(kinds) / sizeof(kinds[0]) ; idx++) {
+		instances->set(
+			Strong<String>(kinds[idx]),
+			Strong<Integer>(snapshot.instances[idx]).as<Type>());
+	}
+
+	Strong<Dictionary<String, Type>> result;
+
+	result->set(Strong<String>("liveBytes"), Strong<Integer>(snapshot.liveBytes).as<Type>());
+	result->set(Strong<String>("peakBytes"), Strong<Integer>(snapshot.peakBytes).as<Type>());
+	result->set(Strong<String>("storageBytes"), Strong<Integer>(snapshot.storageBytes).as<Type>());
+	result->set(Strong<String>("allocations"), allocations.as<Type>());
+	result->set(Strong<String>("instances"), instances.as<Type>());
+
+	return this->stringify(result);
+
+}
+
 bool JSON::_isStringifyable(
 	const Type& data,
 	Data<void*> references
@@ -580,14 +619,9 @@ Strong<String> JSON::_stringify(
 				case Numeric::Subtype::integer:
 					result->append(String::format("%lld", data.as<Integer>().value()));
 					break;
-				case Numeric::Subtype::floatingPoint: {
-					double value = data.as<Float>().value();
-					uint64_t length = snprintf(nullptr, 0, "%g", value);
-					char str[length + 1];
-					snprintf(str, length + 1, "%g", value);
-					result->append(str);
+				case Numeric::Subtype::floatingPoint:
+					result->append(String::format("%g", data.as<Float>().value()));
 					break;
-				}
 			}
 			break;
 		}
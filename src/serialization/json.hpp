@@ -10,6 +10,7 @@
 #define foundation_json_hpp
 
 #include "../memory/object.hpp"
+#include "../memory/statistics.hpp"
 #include "../types/string.hpp"
 
 using namespace foundation::memory;
@@ -100,6 +101,9 @@ namespace foundation::serialization {
 		Strong<String> stringify(
 			const Type& data);
 
+		Strong<String> stringify(
+			const Statistics::Snapshot& snapshot);
+
 	private:
 
 		static bool _isStringifyable(
@@ -0,0 +1,348 @@
+//
+// base64.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FOUNDATION_BASE64_X86
+#endif
+
+#include "../exceptions/exception.hpp"
+#include "./math.hpp"
+
+#include "base64.hpp"
+
+using namespace foundation::tools;
+using namespace foundation::exceptions::types;
+
+struct _Table {
+
+	char characters[64];
+	uint8_t values[256];
+
+	constexpr _Table(char character62, char character63) : characters(), values() {
+		for (size_t idx = 0 ; idx < 256 ; idx++) {
+			values[idx] = 0xFF;
+		}
+		for (size_t idx = 0 ; idx < 64 ; idx++) {
+			char character = (char)(idx < 26 ? 'A' + idx : idx < 52 ? 'a' + (idx - 26) : idx < 62 ? '0' + (idx - 52) : idx == 62 ? character62 : character63);
+			characters[idx] = character;
+			values[(uint8_t)character] = (uint8_t)idx;
+		}
+	}
+
+};
+
+static constexpr _Table _tables[] = {
+	_Table('+', '/'),
+	_Table('-', '_')
+};
+
+static inline uint32_t _value(
+	const _Table& table,
+	const uint8_t* source,
+	size_t index,
+	size_t offset
+) noexcept(false) {
+	uint8_t result = table.values[source[index]];
+	if (result == 0xFF) throw DecoderException(offset + index);
+	return result;
+}
+
+#if defined(FOUNDATION_BASE64_X86)
+
+// Based on Wojciech Muła's SSE base64 algorithms.
+__attribute__((target("ssse3")))
+static size_t _encodeSSSE3(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	const _Table& table
+) {
+
+	// Each group of three bytes is spread over four 32 bit lanes.
+	const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+	// Offsets to add to six bit values, looked up by which range they are in.
+	const __m128i offsets = _mm_setr_epi8(
+		'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, (char)(table.characters[62] - 62), (char)(table.characters[63] - 63), 'A', 0, 0);
+
+	size_t index = 0;
+
+	// Reads 16 bytes to consume 12.
+	for ( ; index + 16 <= length ; index += 12) {
+
+		__m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + index)), shuffle);
+
+		__m128i values = _mm_or_si128(
+			_mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040)),
+			_mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010)));
+
+		__m128i ranges = _mm_subs_epu8(values, _mm_set1_epi8(51));
+		ranges = _mm_or_si128(ranges, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+
+		_mm_storeu_si128((__m128i*)(destination + index / 3 * 4), _mm_add_epi8(values, _mm_shuffle_epi8(offsets, ranges)));
+
+	}
+
+	return index;
+
+}
+
+static inline __m128i _range(
+	__m128i characters,
+	char first,
+	uint8_t count,
+	uint8_t value,
+	__m128i& valid
+) {
+	__m128i offset = _mm_sub_epi8(characters, _mm_set1_epi8(first));
+	__m128i inside = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8((char)(count - 1))), offset);
+	valid = _mm_or_si128(valid, inside);
+	return _mm_and_si128(inside, _mm_add_epi8(offset, _mm_set1_epi8((char)value)));
+}
+
+__attribute__((target("ssse3")))
+static size_t _decodeSSSE3(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	const _Table& table
+) {
+
+	const __m128i character62 = _mm_set1_epi8(table.characters[62]);
+	const __m128i character63 = _mm_set1_epi8(table.characters[63]);
+	const __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+	size_t index = 0;
+
+	for ( ; index + 16 <= length ; index += 16) {
+
+		__m128i characters = _mm_loadu_si128((const __m128i*)(source + index));
+		__m128i is62 = _mm_cmpeq_epi8(characters, character62);
+		__m128i is63 = _mm_cmpeq_epi8(characters, character63);
+		__m128i valid = _mm_or_si128(is62, is63);
+
+		__m128i values = _mm_or_si128(
+			_mm_or_si128(_mm_and_si128(is62, _mm_set1_epi8(62)), _mm_and_si128(is63, _mm_set1_epi8(63))),
+			_mm_or_si128(
+				_range(characters, 'A', 26, 0, valid),
+				_mm_or_si128(_range(characters, 'a', 26, 26, valid), _range(characters, '0', 10, 52, valid))));
+
+		// Invalid characters are left for the scalar loop to report.
+		if (_mm_movemask_epi8(valid) != 0xFFFF) break;
+
+		// Merges four six bit values into 24 bits per lane, then packs the lanes.
+		__m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+		__m128i bytes = _mm_shuffle_epi8(merged, gather);
+
+		uint8_t* output = destination + index / 4 * 3;
+		uint32_t last = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+
+		_mm_storel_epi64((__m128i*)output, bytes);
+		memcpy(output + 8, &last, sizeof(uint32_t));
+
+	}
+
+	return index;
+
+}
+
+static inline bool _hasSSSE3() {
+	static const bool result = __builtin_cpu_supports("ssse3");
+	return result;
+}
+
+#endif
+
+static size_t _encode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	const _Table& table,
+	bool padding
+) {
+
+	size_t index = 0;
+
+#if defined(FOUNDATION_BASE64_X86)
+	if (_hasSSSE3()) index = _encodeSSSE3(source, length, destination, table);
+#endif
+
+	size_t written = index / 3 * 4;
+
+	for ( ; index + 3 <= length ; index += 3) {
+		uint32_t value = (uint32_t)source[index] << 16 | (uint32_t)source[index + 1] << 8 | source[index + 2];
+		destination[written++] = (uint8_t)table.characters[value >> 18];
+		destination[written++] = (uint8_t)table.characters[(value >> 12) & 0x3F];
+		destination[written++] = (uint8_t)table.characters[(value >> 6) & 0x3F];
+		destination[written++] = (uint8_t)table.characters[value & 0x3F];
+	}
+
+	size_t remaining = length - index;
+
+	if (remaining > 0) {
+		uint32_t value = (uint32_t)source[index] << 16 | (remaining > 1 ? (uint32_t)source[index + 1] << 8 : 0);
+		destination[written++] = (uint8_t)table.characters[value >> 18];
+		destination[written++] = (uint8_t)table.characters[(value >> 12) & 0x3F];
+		if (remaining > 1) destination[written++] = (uint8_t)table.characters[(value >> 6) & 0x3F];
+		else if (padding) destination[written++] = '=';
+		if (padding) destination[written++] = '=';
+	}
+
+	return written;
+
+}
+
+// Expects unpadded input. `offset` is added to the indices reported in exceptions.
+static size_t _decode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	const _Table& table,
+	size_t offset
+) noexcept(false) {
+
+	size_t index = 0;
+
+#if defined(FOUNDATION_BASE64_X86)
+	if (_hasSSSE3()) index = _decodeSSSE3(source, length, destination, table);
+#endif
+
+	size_t written = index / 4 * 3;
+
+	for ( ; index + 4 <= length ; index += 4) {
+		uint32_t value = _value(table, source, index, offset) << 18 | _value(table, source, index + 1, offset) << 12 | _value(table, source, index + 2, offset) << 6 | _value(table, source, index + 3, offset);
+		destination[written++] = (uint8_t)(value >> 16);
+		destination[written++] = (uint8_t)(value >> 8);
+		destination[written++] = (uint8_t)value;
+	}
+
+	size_t remaining = length - index;
+
+	if (remaining > 1) {
+		uint32_t value = _value(table, source, index, offset) << 18 | _value(table, source, index + 1, offset) << 12;
+		if (remaining > 2) value |= _value(table, source, index + 2, offset) << 6;
+		// Bits that do not make up a whole byte must be zero, so every input has
+		// a single encoding.
+		if ((value & (remaining > 2 ? 0xFF : 0xFFFF)) != 0) throw DecoderException(offset + length - 1);
+		destination[written++] = (uint8_t)(value >> 16);
+		if (remaining > 2) destination[written++] = (uint8_t)(value >> 8);
+	}
+
+	return written;
+
+}
+
+// Returns the length without padding.
+template<typename C>
+static size_t _unpadded(
+	const C* source,
+	size_t length
+) noexcept(false) {
+
+	size_t result = length;
+
+	while (result > 0 && length - result < 2 && source[result - 1] == '=') {
+		result--;
+	}
+
+	if (result < length && length % 4 != 0) throw DecoderException(result);
+
+	// A single character cannot hold a byte.
+	if (result % 4 == 1) throw DecoderException(result - 1);
+
+	return result;
+
+}
+
+size_t base64::encodedLength(
+	size_t length,
+	bool padding
+) {
+	if (padding) return (length + 2) / 3 * 4;
+	return length / 3 * 4 + (length % 3 != 0 ? length % 3 + 1 : 0);
+}
+
+size_t base64::maximumDecodedLength(
+	size_t length
+) {
+	return (length + 3) / 4 * 3;
+}
+
+size_t base64::encode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	Alphabet alphabet,
+	bool padding
+) {
+	return _encode(source, length, destination, _tables[(size_t)alphabet], padding);
+}
+
+size_t base64::encode(
+	const uint8_t* source,
+	size_t length,
+	uint32_t* destination,
+	Alphabet alphabet,
+	bool padding
+) {
+
+	uint8_t characters[FOUNDATION_BASE64_BLOCK_SIZE / 3 * 4];
+
+	size_t written = 0;
+
+	// Blocks are multiples of three bytes, so only the last one can be padded.
+	for (size_t offset = 0 ; offset < length ; offset += FOUNDATION_BASE64_BLOCK_SIZE) {
+		size_t count = _encode(source + offset, math::min<size_t>(FOUNDATION_BASE64_BLOCK_SIZE, length - offset), characters, _tables[(size_t)alphabet], padding);
+		for (size_t idx = 0 ; idx < count ; idx++) {
+			destination[written + idx] = characters[idx];
+		}
+		written += count;
+	}
+
+	return written;
+
+}
+
+size_t base64::decode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	Alphabet alphabet
+) noexcept(false) {
+	return _decode(source, _unpadded(source, length), destination, _tables[(size_t)alphabet], 0);
+}
+
+size_t base64::decode(
+	const uint32_t* source,
+	size_t length,
+	uint8_t* destination,
+	Alphabet alphabet
+) noexcept(false) {
+
+	length = _unpadded(source, length);
+
+	uint8_t characters[FOUNDATION_BASE64_BLOCK_SIZE / 3 * 4];
+
+	size_t written = 0;
+
+	for (size_t offset = 0 ; offset < length ; offset += sizeof(characters)) {
+		size_t count = math::min(sizeof(characters), length - offset);
+		// Characters outside of Latin-1 are made invalid instead of truncated.
+		for (size_t idx = 0 ; idx < count ; idx++) {
+			characters[idx] = source[offset + idx] > 0xFF ? 0xFF : (uint8_t)source[offset + idx];
+		}
+		written += _decode(characters, count, destination + written, _tables[(size_t)alphabet], offset);
+	}
+
+	return written;
+
+}
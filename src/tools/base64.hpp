@@ -0,0 +1,72 @@
+//
+// base64.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_base64_hpp
+#define foundation_base64_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FOUNDATION_BASE64_BLOCK_SIZE 384
+
+namespace foundation::tools {
+
+	namespace base64 {
+
+		enum class Alphabet {
+			standard = 0,
+			url
+		};
+
+		size_t encodedLength(
+			size_t length,
+			bool padding = true);
+
+		// The decoded length is at most this, less if the input is padded.
+		size_t maximumDecodedLength(
+			size_t length);
+
+		// Returns the number of characters written. Characters can be written as
+		// UTF-32 directly for strings.
+		size_t encode(
+			const uint8_t* source,
+			size_t length,
+			uint8_t* destination,
+			Alphabet alphabet = Alphabet::standard,
+			bool padding = true);
+
+		size_t encode(
+			const uint8_t* source,
+			size_t length,
+			uint32_t* destination,
+			Alphabet alphabet = Alphabet::standard,
+			bool padding = true);
+
+		// Returns the number of bytes written. Padding is optional, but must be
+		// complete if present. Throws `DecoderException` with the index of the
+		// first invalid character – including a last character with bits set that
+		// do not make up a whole byte (like the `h` in `Zh==`).
+		size_t decode(
+			const uint8_t* source,
+			size_t length,
+			uint8_t* destination,
+			Alphabet alphabet = Alphabet::standard
+		) noexcept(false);
+
+		size_t decode(
+			const uint32_t* source,
+			size_t length,
+			uint8_t* destination,
+			Alphabet alphabet = Alphabet::standard
+		) noexcept(false);
+
+	}
+
+}
+
+#endif /* foundation_base64_hpp */
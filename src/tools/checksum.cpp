@@ -0,0 +1,498 @@
+//
+// checksum.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define FOUNDATION_CHECKSUM_X86
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define FOUNDATION_CHECKSUM_ARM
+#endif
+
+#include "./math.hpp"
+
+#include "checksum.hpp"
+
+using namespace foundation::tools;
+
+static const uint32_t _polynomial = 0x82F63B78;
+
+static const uint32_t _prime32[5] = { 2654435761U, 2246822519U, 3266489917U, 668265263U, 374761393U };
+static const uint64_t _prime64[5] = { 11400714785074694791ULL, 14029467366897019727ULL, 1609587929392839161ULL, 9650029242287828579ULL, 2870177450012600261ULL };
+
+static inline uint32_t _read32(
+	const uint8_t* bytes
+) {
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static inline uint64_t _read64(
+	const uint8_t* bytes
+) {
+	return (uint64_t)_read32(bytes) | ((uint64_t)_read32(bytes + 4) << 32);
+}
+
+template<typename T>
+static inline T _rotate(
+	T value,
+	uint32_t bits
+) {
+	return (value << bits) | (value >> (sizeof(T) * 8 - bits));
+}
+
+// CRC-32C
+
+struct _Tables {
+
+	uint32_t items[8][256];
+
+	constexpr _Tables() : items() {
+		for (uint32_t idx = 0 ; idx < 256 ; idx++) {
+			uint32_t crc = idx;
+			for (size_t bit = 0 ; bit < 8 ; bit++) {
+				crc = (crc & 1) != 0 ? (crc >> 1) ^ _polynomial : crc >> 1;
+			}
+			items[0][idx] = crc;
+		}
+		for (size_t slice = 1 ; slice < 8 ; slice++) {
+			for (size_t idx = 0 ; idx < 256 ; idx++) {
+				items[slice][idx] = (items[slice - 1][idx] >> 8) ^ items[0][items[slice - 1][idx] & 0xFF];
+			}
+		}
+	}
+
+};
+
+static constexpr _Tables _tables;
+
+static uint32_t _crcTables(
+	uint32_t crc,
+	const uint8_t* bytes,
+	size_t length
+) {
+
+	const auto& table = _tables.items;
+
+	for ( ; length >= 8 ; bytes += 8, length -= 8) {
+		uint32_t low = _read32(bytes) ^ crc;
+		uint32_t high = _read32(bytes + 4);
+		crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24]
+			^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+	}
+
+	for ( ; length > 0 ; bytes++, length--) {
+		crc = (crc >> 8) ^ table[0][(crc ^ *bytes) & 0xFF];
+	}
+
+	return crc;
+
+}
+
+#if defined(FOUNDATION_CHECKSUM_X86)
+
+// The CRC instruction has a latency of three cycles, but can start one every
+// cycle. Long inputs are therefore split into three interleaved streams, whose
+// CRCs are combined by appending zeros to the earlier ones – which is linear,
+// and done with precomputed tables.
+#define FOUNDATION_CHECKSUM_LONG 8192
+#define FOUNDATION_CHECKSUM_SHORT 256
+
+struct _Shift {
+
+	uint32_t items[4][256];
+
+	static constexpr uint32_t _multiply(const uint32_t* matrix, uint32_t vector) {
+		uint32_t result = 0;
+		for ( ; vector != 0 ; vector >>= 1, matrix++) {
+			if ((vector & 1) != 0) result ^= *matrix;
+		}
+		return result;
+	}
+
+	static constexpr void _square(uint32_t* result, const uint32_t* matrix) {
+		for (size_t idx = 0 ; idx < 32 ; idx++) {
+			result[idx] = _multiply(matrix, matrix[idx]);
+		}
+	}
+
+	// `length` is in bytes and must be a power of two.
+	constexpr _Shift(size_t length) : items() {
+
+		uint32_t even[32] = {};
+		uint32_t odd[32] = {};
+
+		odd[0] = _polynomial;
+
+		for (size_t idx = 1 ; idx < 32 ; idx++) {
+			odd[idx] = (uint32_t)1 << (idx - 1);
+		}
+
+		// Operators for two and four zero bits, then squared up to `length` bytes.
+		_square(even, odd);
+		_square(odd, even);
+
+		const uint32_t* result = odd;
+
+		while (true) {
+			_square(even, odd);
+			result = even;
+			length >>= 1;
+			if (length == 0) break;
+			_square(odd, even);
+			result = odd;
+			length >>= 1;
+			if (length == 0) break;
+		}
+
+		for (uint32_t idx = 0 ; idx < 256 ; idx++) {
+			items[0][idx] = _multiply(result, idx);
+			items[1][idx] = _multiply(result, idx << 8);
+			items[2][idx] = _multiply(result, idx << 16);
+			items[3][idx] = _multiply(result, idx << 24);
+		}
+
+	}
+
+	inline uint32_t operator()(uint32_t crc) const {
+		return this->items[0][crc & 0xFF] ^ this->items[1][(crc >> 8) & 0xFF] ^ this->items[2][(crc >> 16) & 0xFF] ^ this->items[3][crc >> 24];
+	}
+
+};
+
+static constexpr _Shift _long(FOUNDATION_CHECKSUM_LONG);
+static constexpr _Shift _short(FOUNDATION_CHECKSUM_SHORT);
+
+template<size_t Length>
+__attribute__((target("sse4.2")))
+static inline uint32_t _crcInterleaved(
+	uint32_t crc,
+	const uint8_t*& bytes,
+	size_t& length,
+	const _Shift& shift
+) {
+
+	while (length >= Length * 3) {
+
+		uint64_t first = crc;
+		uint64_t second = 0;
+		uint64_t third = 0;
+
+		for (size_t offset = 0 ; offset < Length ; offset += 8) {
+			uint64_t words[3];
+			memcpy(&words[0], bytes + offset, sizeof(uint64_t));
+			memcpy(&words[1], bytes + Length + offset, sizeof(uint64_t));
+			memcpy(&words[2], bytes + Length * 2 + offset, sizeof(uint64_t));
+			first = _mm_crc32_u64(first, words[0]);
+			second = _mm_crc32_u64(second, words[1]);
+			third = _mm_crc32_u64(third, words[2]);
+		}
+
+		crc = shift((uint32_t)first) ^ (uint32_t)second;
+		crc = shift(crc) ^ (uint32_t)third;
+
+		bytes += Length * 3;
+		length -= Length * 3;
+
+	}
+
+	return crc;
+
+}
+
+__attribute__((target("sse4.2")))
+static uint32_t _crcSSE42(
+	uint32_t crc,
+	const uint8_t* bytes,
+	size_t length
+) {
+
+	crc = _crcInterleaved<FOUNDATION_CHECKSUM_LONG>(crc, bytes, length, _long);
+	crc = _crcInterleaved<FOUNDATION_CHECKSUM_SHORT>(crc, bytes, length, _short);
+
+	uint64_t state = crc;
+
+	for ( ; length >= 8 ; bytes += 8, length -= 8) {
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(uint64_t));
+		state = _mm_crc32_u64(state, word);
+	}
+
+	crc = (uint32_t)state;
+
+	for ( ; length > 0 ; bytes++, length--) {
+		crc = _mm_crc32_u8(crc, *bytes);
+	}
+
+	return crc;
+
+}
+
+static inline bool _hasSSE42() {
+	static const bool result = __builtin_cpu_supports("sse4.2");
+	return result;
+}
+
+#elif defined(FOUNDATION_CHECKSUM_ARM)
+
+static uint32_t _crcARM(
+	uint32_t crc,
+	const uint8_t* bytes,
+	size_t length
+) {
+
+	for ( ; length >= 8 ; bytes += 8, length -= 8) {
+		uint64_t word;
+		memcpy(&word, bytes, sizeof(uint64_t));
+		crc = __crc32cd(crc, word);
+	}
+
+	for ( ; length > 0 ; bytes++, length--) {
+		crc = __crc32cb(crc, *bytes);
+	}
+
+	return crc;
+
+}
+
+#endif
+
+uint32_t checksum::CRC32C::compute(
+	const uint8_t* bytes,
+	size_t length
+) {
+	CRC32C checksum;
+	checksum.update(bytes, length);
+	return checksum.value();
+}
+
+checksum::CRC32C::CRC32C() : _state(0xFFFFFFFF) { }
+
+void checksum::CRC32C::update(
+	const uint8_t* bytes,
+	size_t length
+) {
+#if defined(FOUNDATION_CHECKSUM_X86)
+	if (_hasSSE42()) {
+		this->_state = _crcSSE42(this->_state, bytes, length);
+		return;
+	}
+#elif defined(FOUNDATION_CHECKSUM_ARM) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	this->_state = _crcARM(this->_state, bytes, length);
+	return;
+#endif
+	this->_state = _crcTables(this->_state, bytes, length);
+}
+
+uint32_t checksum::CRC32C::value() const {
+	return ~this->_state;
+}
+
+// XXH32
+
+static inline uint32_t _round32(
+	uint32_t accumulator,
+	uint32_t input
+) {
+	return _rotate(accumulator + input * _prime32[1], 13) * _prime32[0];
+}
+
+uint32_t checksum::XXHash32::compute(
+	const uint8_t* bytes,
+	size_t length,
+	uint32_t seed
+) {
+	XXHash32 checksum(seed);
+	checksum.update(bytes, length);
+	return checksum.value();
+}
+
+checksum::XXHash32::XXHash32(
+	uint32_t seed
+) : _seed(seed),
+	_state { seed + _prime32[0] + _prime32[1], seed + _prime32[1], seed, seed - _prime32[0] },
+	_pendingLength(0),
+	_length(0) { }
+
+void checksum::XXHash32::update(
+	const uint8_t* bytes,
+	size_t length
+) {
+
+	this->_length += length;
+
+	if (this->_pendingLength > 0) {
+		size_t count = math::min(sizeof(this->_pending) - this->_pendingLength, length);
+		memcpy(this->_pending + this->_pendingLength, bytes, count);
+		this->_pendingLength += count;
+		bytes += count;
+		length -= count;
+		if (this->_pendingLength < sizeof(this->_pending)) return;
+		for (size_t idx = 0 ; idx < 4 ; idx++) {
+			this->_state[idx] = _round32(this->_state[idx], _read32(this->_pending + idx * 4));
+		}
+		this->_pendingLength = 0;
+	}
+
+	uint32_t state[4] = { this->_state[0], this->_state[1], this->_state[2], this->_state[3] };
+
+	for ( ; length >= 16 ; bytes += 16, length -= 16) {
+		state[0] = _round32(state[0], _read32(bytes));
+		state[1] = _round32(state[1], _read32(bytes + 4));
+		state[2] = _round32(state[2], _read32(bytes + 8));
+		state[3] = _round32(state[3], _read32(bytes + 12));
+	}
+
+	memcpy(this->_state, state, sizeof(state));
+
+	memcpy(this->_pending, bytes, length);
+	this->_pendingLength = length;
+
+}
+
+uint32_t checksum::XXHash32::value() const {
+
+	uint32_t result;
+
+	if (this->_length >= 16) {
+		result = _rotate(this->_state[0], 1) + _rotate(this->_state[1], 7) + _rotate(this->_state[2], 12) + _rotate(this->_state[3], 18);
+	} else {
+		result = this->_seed + _prime32[4];
+	}
+
+	result += (uint32_t)this->_length;
+
+	size_t idx = 0;
+
+	for ( ; idx + 4 <= this->_pendingLength ; idx += 4) {
+		result = _rotate(result + _read32(this->_pending + idx) * _prime32[2], 17) * _prime32[3];
+	}
+
+	for ( ; idx < this->_pendingLength ; idx++) {
+		result = _rotate(result + this->_pending[idx] * _prime32[4], 11) * _prime32[0];
+	}
+
+	result ^= result >> 15;
+	result *= _prime32[1];
+	result ^= result >> 13;
+	result *= _prime32[2];
+	result ^= result >> 16;
+
+	return result;
+
+}
+
+// XXH64
+
+static inline uint64_t _round64(
+	uint64_t accumulator,
+	uint64_t input
+) {
+	return _rotate(accumulator + input * _prime64[1], 31) * _prime64[0];
+}
+
+static inline uint64_t _merge64(
+	uint64_t accumulator,
+	uint64_t value
+) {
+	return (accumulator ^ _round64(0, value)) * _prime64[0] + _prime64[3];
+}
+
+uint64_t checksum::XXHash64::compute(
+	const uint8_t* bytes,
+	size_t length,
+	uint64_t seed
+) {
+	XXHash64 checksum(seed);
+	checksum.update(bytes, length);
+	return checksum.value();
+}
+
+checksum::XXHash64::XXHash64(
+	uint64_t seed
+) : _seed(seed),
+	_state { seed + _prime64[0] + _prime64[1], seed + _prime64[1], seed, seed - _prime64[0] },
+	_pendingLength(0),
+	_length(0) { }
+
+void checksum::XXHash64::update(
+	const uint8_t* bytes,
+	size_t length
+) {
+
+	this->_length += length;
+
+	if (this->_pendingLength > 0) {
+		size_t count = math::min(sizeof(this->_pending) - this->_pendingLength, length);
+		memcpy(this->_pending + this->_pendingLength, bytes, count);
+		this->_pendingLength += count;
+		bytes += count;
+		length -= count;
+		if (this->_pendingLength < sizeof(this->_pending)) return;
+		for (size_t idx = 0 ; idx < 4 ; idx++) {
+			this->_state[idx] = _round64(this->_state[idx], _read64(this->_pending + idx * 8));
+		}
+		this->_pendingLength = 0;
+	}
+
+	uint64_t state[4] = { this->_state[0], this->_state[1], this->_state[2], this->_state[3] };
+
+	for ( ; length >= 32 ; bytes += 32, length -= 32) {
+		state[0] = _round64(state[0], _read64(bytes));
+		state[1] = _round64(state[1], _read64(bytes + 8));
+		state[2] = _round64(state[2], _read64(bytes + 16));
+		state[3] = _round64(state[3], _read64(bytes + 24));
+	}
+
+	memcpy(this->_state, state, sizeof(state));
+
+	memcpy(this->_pending, bytes, length);
+	this->_pendingLength = length;
+
+}
+
+uint64_t checksum::XXHash64::value() const {
+
+	uint64_t result;
+
+	if (this->_length >= 32) {
+		result = _rotate(this->_state[0], 1) + _rotate(this->_state[1], 7) + _rotate(this->_state[2], 12) + _rotate(this->_state[3], 18);
+		for (size_t idx = 0 ; idx < 4 ; idx++) {
+			result = _merge64(result, this->_state[idx]);
+		}
+	} else {
+		result = this->_seed + _prime64[4];
+	}
+
+	result += this->_length;
+
+	size_t idx = 0;
+
+	for ( ; idx + 8 <= this->_pendingLength ; idx += 8) {
+		result = _rotate(result ^ _round64(0, _read64(this->_pending + idx)), 27) * _prime64[0] + _prime64[3];
+	}
+
+	if (idx + 4 <= this->_pendingLength) {
+		result = _rotate(result ^ (uint64_t)_read32(this->_pending + idx) * _prime64[0], 23) * _prime64[1] + _prime64[2];
+		idx += 4;
+	}
+
+	for ( ; idx < this->_pendingLength ; idx++) {
+		result = _rotate(result ^ this->_pending[idx] * _prime64[4], 11) * _prime64[0];
+	}
+
+	result ^= result >> 33;
+	result *= _prime64[1];
+	result ^= result >> 29;
+	result *= _prime64[2];
+	result ^= result >> 32;
+
+	return result;
+
+}
@@ -0,0 +1,109 @@
+//
+// checksum.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_checksum_hpp
+#define foundation_checksum_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace foundation::tools {
+
+	// Checksums that can be computed in one go or updated as input arrives.
+	// Unlike `Hashable::hashBytes`, the results never depend on the process, so
+	// they can be stored and compared across machines.
+	namespace checksum {
+
+		// CRC-32C (Castagnoli), as used by iSCSI, ext4 and SCTP. Uses the SSE 4.2
+		// or ARMv8 CRC instructions when available, and slicing-by-8 tables
+		// otherwise.
+		class CRC32C {
+
+			public:
+
+				static uint32_t compute(
+					const uint8_t* bytes,
+					size_t length);
+
+				CRC32C();
+
+				void update(
+					const uint8_t* bytes,
+					size_t length);
+
+				uint32_t value() const;
+
+			private:
+
+				uint32_t _state;
+
+		};
+
+		// XXH32, as used by the LZ4 frame format.
+		class XXHash32 {
+
+			public:
+
+				static uint32_t compute(
+					const uint8_t* bytes,
+					size_t length,
+					uint32_t seed = 0);
+
+				XXHash32(
+					uint32_t seed = 0);
+
+				void update(
+					const uint8_t* bytes,
+					size_t length);
+
+				uint32_t value() const;
+
+			private:
+
+				uint32_t _seed;
+				uint32_t _state[4];
+				uint8_t _pending[16];
+				size_t _pendingLength;
+				uint64_t _length;
+
+		};
+
+		// XXH64, a fast 64 bit digest.
+		class XXHash64 {
+
+			public:
+
+				static uint64_t compute(
+					const uint8_t* bytes,
+					size_t length,
+					uint64_t seed = 0);
+
+				XXHash64(
+					uint64_t seed = 0);
+
+				void update(
+					const uint8_t* bytes,
+					size_t length);
+
+				uint64_t value() const;
+
+			private:
+
+				uint64_t _seed;
+				uint64_t _state[4];
+				uint8_t _pending[32];
+				size_t _pendingLength;
+				uint64_t _length;
+
+		};
+
+	}
+
+}
+
+#endif /* foundation_checksum_hpp */
@@ -0,0 +1,275 @@
+//
+// hex.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FOUNDATION_HEX_X86
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FOUNDATION_HEX_NEON
+#endif
+
+#include "../exceptions/exception.hpp"
+#include "./math.hpp"
+
+#include "hex.hpp"
+
+using namespace foundation::tools;
+using namespace foundation::exceptions::types;
+
+static const char _lowercase[] = "0123456789abcdef";
+static const char _uppercase[] = "0123456789ABCDEF";
+
+static inline uint8_t _value(
+	uint32_t character
+) {
+	if (character >= '0' && character <= '9') return (uint8_t)(character - '0');
+	if (character >= 'a' && character <= 'f') return (uint8_t)(character - 'a' + 10);
+	if (character >= 'A' && character <= 'F') return (uint8_t)(character - 'A' + 10);
+	return 0xFF;
+}
+
+#if defined(FOUNDATION_HEX_X86)
+
+__attribute__((target("ssse3")))
+static size_t _encodeSSSE3(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	const char* digits
+) {
+
+	const __m128i table = _mm_loadu_si128((const __m128i*)digits);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+
+	size_t index = 0;
+
+	for ( ; index + 16 <= length ; index += 16) {
+		__m128i bytes = _mm_loadu_si128((const __m128i*)(source + index));
+		__m128i high = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+		__m128i low = _mm_shuffle_epi8(table, _mm_and_si128(bytes, mask));
+		_mm_storeu_si128((__m128i*)(destination + index * 2), _mm_unpacklo_epi8(high, low));
+		_mm_storeu_si128((__m128i*)(destination + index * 2 + 16), _mm_unpackhi_epi8(high, low));
+	}
+
+	return index;
+
+}
+
+// Unsigned range checks, as SSE only compares signed bytes.
+static inline __m128i _values(
+	__m128i characters,
+	__m128i& valid
+) {
+	__m128i digits = _mm_sub_epi8(characters, _mm_set1_epi8('0'));
+	__m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+	__m128i letters = _mm_sub_epi8(_mm_or_si128(characters, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(5)), letters);
+	valid = _mm_or_si128(isDigit, isLetter);
+	return _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, _mm_add_epi8(letters, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+static size_t _decodeSSSE3(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination
+) {
+
+	// Multiplies the high nibble of each pair by 16 and adds the low one.
+	const __m128i weights = _mm_set1_epi16(0x0110);
+
+	size_t index = 0;
+
+	for ( ; index + 32 <= length ; index += 32) {
+		__m128i firstValid, secondValid;
+		__m128i first = _values(_mm_loadu_si128((const __m128i*)(source + index)), firstValid);
+		__m128i second = _values(_mm_loadu_si128((const __m128i*)(source + index + 16)), secondValid);
+		// Invalid characters are left for the scalar loop to report.
+		if (_mm_movemask_epi8(_mm_and_si128(firstValid, secondValid)) != 0xFFFF) break;
+		_mm_storeu_si128((__m128i*)(destination + index / 2), _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights)));
+	}
+
+	return index;
+
+}
+
+static inline bool _hasSSSE3() {
+	static const bool result = __builtin_cpu_supports("ssse3");
+	return result;
+}
+
+#elif defined(FOUNDATION_HEX_NEON)
+
+static size_t _encodeNEON(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	const char* digits
+) {
+
+	const uint8x16_t table = vld1q_u8((const uint8_t*)digits);
+	const uint8x16_t mask = vdupq_n_u8(0x0F);
+
+	size_t index = 0;
+
+	for ( ; index + 16 <= length ; index += 16) {
+		uint8x16_t bytes = vld1q_u8(source + index);
+		uint8x16x2_t characters;
+		characters.val[0] = vqtbl1q_u8(table, vshrq_n_u8(bytes, 4));
+		characters.val[1] = vqtbl1q_u8(table, vandq_u8(bytes, mask));
+		vst2q_u8(destination + index * 2, characters);
+	}
+
+	return index;
+
+}
+
+static inline uint8x16_t _values(
+	uint8x16_t characters,
+	uint8x16_t& valid
+) {
+	uint8x16_t digits = vsubq_u8(characters, vdupq_n_u8('0'));
+	uint8x16_t isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+	uint8x16_t letters = vsubq_u8(vorrq_u8(characters, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+	uint8x16_t isLetter = vcleq_u8(letters, vdupq_n_u8(5));
+	valid = vorrq_u8(isDigit, isLetter);
+	return vbslq_u8(isDigit, digits, vaddq_u8(letters, vdupq_n_u8(10)));
+}
+
+static size_t _decodeNEON(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination
+) {
+
+	size_t index = 0;
+
+	for ( ; index + 32 <= length ; index += 32) {
+		uint8x16x2_t characters = vld2q_u8(source + index);
+		uint8x16_t highValid, lowValid;
+		uint8x16_t high = _values(characters.val[0], highValid);
+		uint8x16_t low = _values(characters.val[1], lowValid);
+		// Invalid characters are left for the scalar loop to report.
+		if (vminvq_u8(vandq_u8(highValid, lowValid)) == 0) break;
+		vst1q_u8(destination + index / 2, vorrq_u8(vshlq_n_u8(high, 4), low));
+	}
+
+	return index;
+
+}
+
+#endif
+
+static void _encode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	bool uppercase
+) {
+
+	const char* digits = uppercase ? _uppercase : _lowercase;
+
+	size_t index = 0;
+
+#if defined(FOUNDATION_HEX_X86)
+	if (_hasSSSE3()) index = _encodeSSSE3(source, length, destination, digits);
+#elif defined(FOUNDATION_HEX_NEON)
+	index = _encodeNEON(source, length, destination, digits);
+#endif
+
+	for ( ; index < length ; index++) {
+		destination[index * 2] = (uint8_t)digits[source[index] >> 4];
+		destination[index * 2 + 1] = (uint8_t)digits[source[index] & 0x0F];
+	}
+
+}
+
+// `offset` is added to the indices reported in exceptions.
+static void _decode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	size_t offset
+) noexcept(false) {
+
+	size_t index = 0;
+
+#if defined(FOUNDATION_HEX_X86)
+	if (_hasSSSE3()) index = _decodeSSSE3(source, length, destination);
+#elif defined(FOUNDATION_HEX_NEON)
+	index = _decodeNEON(source, length, destination);
+#endif
+
+	for ( ; index < length ; index += 2) {
+		uint8_t high = _value(source[index]);
+		if (high == 0xFF) throw DecoderException(offset + index);
+		uint8_t low = _value(source[index + 1]);
+		if (low == 0xFF) throw DecoderException(offset + index + 1);
+		destination[index / 2] = (uint8_t)(high << 4 | low);
+	}
+
+}
+
+void hex::encode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination,
+	bool uppercase
+) {
+	_encode(source, length, destination, uppercase);
+}
+
+void hex::encode(
+	const uint8_t* source,
+	size_t length,
+	uint32_t* destination,
+	bool uppercase
+) {
+
+	uint8_t characters[FOUNDATION_HEX_BLOCK_SIZE * 2];
+
+	for (size_t offset = 0 ; offset < length ; offset += FOUNDATION_HEX_BLOCK_SIZE) {
+		size_t count = math::min<size_t>(FOUNDATION_HEX_BLOCK_SIZE, length - offset);
+		_encode(source + offset, count, characters, uppercase);
+		for (size_t idx = 0 ; idx < count * 2 ; idx++) {
+			destination[offset * 2 + idx] = characters[idx];
+		}
+	}
+
+}
+
+void hex::decode(
+	const uint8_t* source,
+	size_t length,
+	uint8_t* destination
+) noexcept(false) {
+	if (length % 2 != 0) throw DecoderException(length);
+	_decode(source, length, destination, 0);
+}
+
+void hex::decode(
+	const uint32_t* source,
+	size_t length,
+	uint8_t* destination
+) noexcept(false) {
+
+	if (length % 2 != 0) throw DecoderException(length);
+
+	uint8_t characters[FOUNDATION_HEX_BLOCK_SIZE];
+
+	for (size_t offset = 0 ; offset < length ; offset += FOUNDATION_HEX_BLOCK_SIZE) {
+		size_t count = math::min<size_t>(FOUNDATION_HEX_BLOCK_SIZE, length - offset);
+		// Characters outside of Latin-1 are made invalid instead of truncated.
+		for (size_t idx = 0 ; idx < count ; idx++) {
+			characters[idx] = source[offset + idx] > 0xFF ? 0xFF : (uint8_t)source[offset + idx];
+		}
+		_decode(characters, count, destination + offset / 2, offset);
+	}
+
+}
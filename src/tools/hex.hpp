@@ -0,0 +1,54 @@
+//
+// hex.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_hex_hpp
+#define foundation_hex_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FOUNDATION_HEX_BLOCK_SIZE 512
+
+namespace foundation::tools {
+
+	namespace hex {
+
+		// Writes two characters per byte, so `destination` must hold `length * 2`
+		// items. Characters can be written as UTF-32 directly for strings.
+		void encode(
+			const uint8_t* source,
+			size_t length,
+			uint8_t* destination,
+			bool uppercase = true);
+
+		void encode(
+			const uint8_t* source,
+			size_t length,
+			uint32_t* destination,
+			bool uppercase = true);
+
+		// Accepts both cases, and writes `length / 2` bytes to `destination`.
+		// Throws `DecoderException` with the index of the first invalid character,
+		// or with `length` if it is odd.
+		void decode(
+			const uint8_t* source,
+			size_t length,
+			uint8_t* destination
+		) noexcept(false);
+
+		void decode(
+			const uint32_t* source,
+			size_t length,
+			uint8_t* destination
+		) noexcept(false);
+
+	}
+
+}
+
+#endif /* foundation_hex_hpp */
@@ -0,0 +1,763 @@
+//
+// lz4.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../exceptions/exception.hpp"
+#include "./math.hpp"
+
+#include "lz4.hpp"
+
+using namespace foundation::tools;
+using namespace foundation::exceptions::tools;
+
+static const size_t _minimumMatch = 4;
+static const size_t _lastLiterals = 5;
+static const size_t _matchFindLimit = 12;
+static const size_t _maximumDistance = 65535;
+static const size_t _maximumInput = 0x7E000000;
+static const uint32_t _skipTrigger = 6;
+
+// The fast decoding loop copies in whole 8 and 16 byte words, and may read and
+// write past the end of a sequence. It runs while this much input and output is
+// left, and hands the rest to the checked loop.
+static const size_t _fastInputMargin = 32;
+static const size_t _fastOutputMargin = 64;
+
+// Adjusts the source of matches with offsets below 8, so that after the first 8
+// bytes are copied one by one, the rest can be copied 8 bytes at a time.
+static const uint32_t _overlapIncrements[8] = { 0, 1, 2, 1, 0, 4, 4, 4 };
+static const int32_t _overlapDecrements[8] = { 0, 0, 0, -1, -4, 1, 2, 3 };
+
+static const uint32_t _frameMagic = 0x184D2204;
+static const uint32_t _skippableMagic = 0x184D2A50;
+static const uint32_t _uncompressedFlag = 0x80000000;
+
+static const uint32_t _hashPrime = 2654435761U;
+
+static inline uint32_t _read32(
+	const uint8_t* bytes
+) {
+	uint32_t result;
+	memcpy(&result, bytes, sizeof(uint32_t));
+	return result;
+}
+
+static inline uint64_t _read64(
+	const uint8_t* bytes
+) {
+	uint64_t result;
+	memcpy(&result, bytes, sizeof(uint64_t));
+	return result;
+}
+
+static inline uint32_t _readLE32(
+	const uint8_t* bytes
+) {
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static inline uint64_t _readLE64(
+	const uint8_t* bytes
+) {
+	return (uint64_t)_readLE32(bytes) | ((uint64_t)_readLE32(bytes + 4) << 32);
+}
+
+static inline void _writeLE32(
+	uint8_t* bytes,
+	uint32_t value
+) {
+	bytes[0] = (uint8_t)value;
+	bytes[1] = (uint8_t)(value >> 8);
+	bytes[2] = (uint8_t)(value >> 16);
+	bytes[3] = (uint8_t)(value >> 24);
+}
+
+// Number of equal bytes at `a` and `b`, not reading at or beyond `limit`.
+static inline size_t _count(
+	const uint8_t* a,
+	const uint8_t* b,
+	const uint8_t* limit
+) {
+
+	const uint8_t* start = a;
+
+	while (a + sizeof(uint64_t) <= limit) {
+		uint64_t difference = _read64(a) ^ _read64(b);
+		if (difference != 0) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			return (size_t)(a - start) + (size_t)__builtin_ctzll(difference) / 8;
+#else
+			return (size_t)(a - start) + (size_t)__builtin_clzll(difference) / 8;
+#endif
+		}
+		a += sizeof(uint64_t);
+		b += sizeof(uint64_t);
+	}
+
+	while (a < limit && *a == *b) {
+		a++;
+		b++;
+	}
+
+	return (size_t)(a - start);
+
+}
+
+// Copies at least `length` bytes in 8 byte words.
+static inline void _wildCopy8(
+	uint8_t* destination,
+	const uint8_t* source,
+	size_t length
+) {
+	uint8_t* end = destination + length;
+	do {
+		memcpy(destination, source, 8);
+		destination += 8;
+		source += 8;
+	} while (destination < end);
+}
+
+// Copies at least `length` bytes in 16 byte words.
+static inline void _wildCopy16(
+	uint8_t* destination,
+	const uint8_t* source,
+	size_t length
+) {
+	uint8_t* end = destination + length;
+	do {
+		memcpy(destination, source, 16);
+		destination += 16;
+		source += 16;
+	} while (destination < end);
+}
+
+// Copies exactly `length` bytes of a match that may overlap its output.
+static inline void _copyMatch(
+	uint8_t* output,
+	size_t offset,
+	size_t length
+) {
+	const uint8_t* match = output - offset;
+	if (offset >= length) {
+		memcpy(output, match, length);
+		return;
+	}
+	// Overlapping matches repeat the last `offset` bytes. Copying whole periods
+	// from the start of the match doubles the span that can be copied each time.
+	size_t copied = 0;
+	while (copied < length) {
+		size_t count = math::min(offset + copied, length - copied);
+		memcpy(output + copied, match, count);
+		copied += count;
+	}
+}
+
+static inline uint8_t* _writeLength(
+	uint8_t* output,
+	size_t length
+) {
+	while (length >= 255) {
+		*output++ = 255;
+		length -= 255;
+	}
+	*output++ = (uint8_t)length;
+	return output;
+}
+
+static inline size_t _readLength(
+	const uint8_t*& input,
+	const uint8_t* inputEnd,
+	const uint8_t* source
+) noexcept(false) {
+	size_t result = 0;
+	uint8_t byte;
+	do {
+		if (input >= inputEnd) throw MalformedCompressedDataException((size_t)(input - source));
+		byte = *input++;
+		result += byte;
+	} while (byte == 255);
+	return result;
+}
+
+size_t lz4::blockBound(
+	size_t length
+) {
+	return length + length / 255 + 16;
+}
+
+size_t lz4::compressBlock(
+	const uint8_t* source,
+	size_t sourceLength,
+	uint8_t* destination,
+	size_t destinationCapacity
+) {
+
+	if (sourceLength > _maximumInput) return 0;
+
+	const uint8_t* input = source;
+	const uint8_t* inputEnd = source + sourceLength;
+	const uint8_t* anchor = source;
+	uint8_t* output = destination;
+	uint8_t* outputEnd = destination + destinationCapacity;
+
+	if (sourceLength > _matchFindLimit) {
+
+		// Small inputs do not need – or pay for clearing – the full table.
+		uint32_t hashLog = math::min<uint32_t>(FOUNDATION_LZ4_HASH_LOG, math::max<uint32_t>(8, 64 - __builtin_clzll(sourceLength)));
+		uint32_t table[1 << FOUNDATION_LZ4_HASH_LOG];
+
+		memset(table, 0, sizeof(uint32_t) << hashLog);
+
+		const uint8_t* matchLimit = inputEnd - _lastLiterals;
+		const uint8_t* findLimit = inputEnd - _matchFindLimit;
+
+		auto hash = [hashLog](const uint8_t* position) {
+			return (_read32(position) * _hashPrime) >> (32 - hashLog);
+		};
+
+		input++;
+
+		while (true) {
+
+			const uint8_t* match;
+			const uint8_t* next = input;
+			uint32_t attempts = 1 << _skipTrigger;
+
+			// Step further ahead the longer nothing is found, so incompressible input is skipped quickly.
+			do {
+				input = next;
+				next = input + (attempts++ >> _skipTrigger);
+				if (next > findLimit) goto lastLiterals;
+				uint32_t key = hash(input);
+				match = source + table[key];
+				table[key] = (uint32_t)(input - source);
+			} while (match + _maximumDistance < input || _read32(match) != _read32(input));
+
+			while (input > anchor && match > source && input[-1] == match[-1]) {
+				input--;
+				match--;
+			}
+
+			size_t literals = (size_t)(input - anchor);
+			size_t matchLength = _count(input + _minimumMatch, match + _minimumMatch, matchLimit);
+
+			if ((size_t)(outputEnd - output) < 1 + literals / 255 + 1 + literals + 2 + matchLength / 255 + 1) return 0;
+
+			uint8_t* token = output++;
+
+			if (literals >= 15) {
+				*token = 15 << 4;
+				output = _writeLength(output, literals - 15);
+			} else {
+				*token = (uint8_t)(literals << 4);
+			}
+
+			memcpy(output, anchor, literals);
+			output += literals;
+
+			size_t offset = (size_t)(input - match);
+
+			*output++ = (uint8_t)offset;
+			*output++ = (uint8_t)(offset >> 8);
+
+			if (matchLength >= 15) {
+				*token |= 15;
+				output = _writeLength(output, matchLength - 15);
+			} else {
+				*token |= (uint8_t)matchLength;
+			}
+
+			input += _minimumMatch + matchLength;
+			anchor = input;
+
+			if (input > findLimit) break;
+
+			uint32_t key = hash(input - 2);
+			table[key] = (uint32_t)(input - 2 - source);
+
+		}
+
+	}
+
+lastLiterals:
+
+	size_t literals = (size_t)(inputEnd - anchor);
+
+	if ((size_t)(outputEnd - output) < 1 + literals / 255 + 1 + literals) return 0;
+
+	if (literals >= 15) {
+		*output++ = 15 << 4;
+		output = _writeLength(output, literals - 15);
+	} else {
+		*output++ = (uint8_t)(literals << 4);
+	}
+
+	if (literals > 0) memcpy(output, anchor, literals);
+	output += literals;
+
+	return (size_t)(output - destination);
+
+}
+
+size_t lz4::decompressBlock(
+	const uint8_t* source,
+	size_t sourceLength,
+	uint8_t* destination,
+	size_t destinationCapacity,
+	size_t prefixLength
+) noexcept(false) {
+
+	const uint8_t* input = source;
+	const uint8_t* inputEnd = source + sourceLength;
+	uint8_t* output = destination;
+	uint8_t* outputEnd = destination + destinationCapacity;
+	const uint8_t* lowest = destination - prefixLength;
+
+	while ((size_t)(inputEnd - input) >= _fastInputMargin && (size_t)(outputEnd - output) >= _fastOutputMargin) {
+
+		const uint8_t* sequence = input;
+		uint8_t* sequenceOutput = output;
+
+		uint8_t token = *input++;
+
+		size_t literals = token >> 4;
+
+		if (literals < 15) {
+			// Both margins cover a 16 byte copy.
+			memcpy(output, input, 16);
+		} else {
+			literals += _readLength(input, inputEnd, source);
+			// The last sequence, and sequences close to the end, are left to the
+			// checked loop.
+			if (literals > (size_t)(inputEnd - input) - math::min<size_t>(inputEnd - input, 18) || literals > (size_t)(outputEnd - output) - _fastOutputMargin / 2) {
+				input = sequence;
+				output = sequenceOutput;
+				break;
+			}
+			_wildCopy16(output, input, literals);
+		}
+
+		input += literals;
+		output += literals;
+
+		if ((size_t)(inputEnd - input) < 18) {
+			input = sequence;
+			output = sequenceOutput;
+			break;
+		}
+
+		size_t offset = (size_t)input[0] | ((size_t)input[1] << 8);
+
+		if (offset == 0 || offset > (size_t)(output - lowest)) throw MalformedCompressedDataException((size_t)(input - source));
+
+		input += 2;
+
+		size_t matchLength = token & 15;
+		const uint8_t* match = output - offset;
+
+		// Matches of up to 18 bytes at offsets of at least 8 are three word copies.
+		if (matchLength < 15 && offset >= 8 && (size_t)(outputEnd - output) >= 24) {
+			memcpy(output, match, 8);
+			memcpy(output + 8, match + 8, 8);
+			memcpy(output + 16, match + 16, 8);
+			output += matchLength + _minimumMatch;
+			continue;
+		}
+
+		if (matchLength == 15) matchLength += _readLength(input, inputEnd, source);
+
+		matchLength += _minimumMatch;
+
+		if (matchLength > (size_t)(outputEnd - output)) throw MalformedCompressedDataException((size_t)(input - source));
+
+		if (matchLength + 16 > (size_t)(outputEnd - output)) {
+			_copyMatch(output, offset, matchLength);
+		} else if (offset >= 16) {
+			_wildCopy16(output, match, matchLength);
+		} else if (offset >= 8) {
+			_wildCopy8(output, match, matchLength);
+		} else {
+			output[0] = match[0];
+			output[1] = match[1];
+			output[2] = match[2];
+			output[3] = match[3];
+			match += _overlapIncrements[offset];
+			memcpy(output + 4, match, 4);
+			match -= _overlapDecrements[offset];
+			if (matchLength > 8) _wildCopy8(output + 8, match, matchLength - 8);
+		}
+
+		output += matchLength;
+
+	}
+
+	while (true) {
+
+		if (input >= inputEnd) throw MalformedCompressedDataException((size_t)(input - source));
+
+		uint8_t token = *input++;
+
+		size_t literals = token >> 4;
+
+		if (literals == 15) literals += _readLength(input, inputEnd, source);
+
+		if (literals > (size_t)(inputEnd - input) || literals > (size_t)(outputEnd - output)) {
+			throw MalformedCompressedDataException((size_t)(input - source));
+		}
+
+		memcpy(output, input, literals);
+		input += literals;
+		output += literals;
+
+		// The last sequence has literals only.
+		if (input == inputEnd) break;
+
+		if (inputEnd - input < 2) throw MalformedCompressedDataException((size_t)(input - source));
+
+		size_t offset = (size_t)input[0] | ((size_t)input[1] << 8);
+
+		if (offset == 0 || offset > (size_t)(output - lowest)) throw MalformedCompressedDataException((size_t)(input - source));
+
+		input += 2;
+
+		size_t matchLength = token & 15;
+
+		if (matchLength == 15) matchLength += _readLength(input, inputEnd, source);
+
+		matchLength += _minimumMatch;
+
+		if (matchLength > (size_t)(outputEnd - output)) throw MalformedCompressedDataException((size_t)(input - source));
+
+		_copyMatch(output, offset, matchLength);
+
+		output += matchLength;
+
+	}
+
+	return (size_t)(output - destination);
+
+}
+
+lz4::Encoder::Encoder(
+	const Output& output,
+	BlockSize blockSize
+) : _output(output),
+	_blockSize((size_t)1 << (8 + 2 * (size_t)blockSize)),
+	_buffer((uint8_t*)malloc(this->_blockSize)),
+	_bufferLength(0),
+	_compressed((uint8_t*)malloc(4 + this->_blockSize)),
+	_isFinished(false) {
+
+	uint8_t header[7];
+
+	_writeLE32(header, _frameMagic);
+
+	// Version 01, independent blocks and a content checksum.
+	header[4] = 0x64;
+	header[5] = (uint8_t)((size_t)blockSize << 4);
+	header[6] = (uint8_t)(checksum::XXHash32::compute(header + 4, 2) >> 8);
+
+	this->_output(header, sizeof(header));
+
+}
+
+lz4::Encoder::~Encoder() {
+	free(this->_buffer);
+	free(this->_compressed);
+}
+
+void lz4::Encoder::write(
+	const uint8_t* bytes,
+	size_t length
+) noexcept(false) {
+
+	this->_checksum.update(bytes, length);
+
+	while (length > 0) {
+
+		if (this->_bufferLength == 0 && length >= this->_blockSize) {
+			this->_block(bytes, this->_blockSize);
+			bytes += this->_blockSize;
+			length -= this->_blockSize;
+			continue;
+		}
+
+		size_t count = math::min(this->_blockSize - this->_bufferLength, length);
+
+		memcpy(this->_buffer + this->_bufferLength, bytes, count);
+		this->_bufferLength += count;
+		bytes += count;
+		length -= count;
+
+		if (this->_bufferLength == this->_blockSize) {
+			this->_block(this->_buffer, this->_bufferLength);
+			this->_bufferLength = 0;
+		}
+
+	}
+
+}
+
+void lz4::Encoder::finish() noexcept(false) {
+
+	if (this->_isFinished) return;
+
+	if (this->_bufferLength > 0) {
+		this->_block(this->_buffer, this->_bufferLength);
+		this->_bufferLength = 0;
+	}
+
+	uint8_t trailer[8];
+
+	_writeLE32(trailer, 0);
+	_writeLE32(trailer + 4, this->_checksum.value());
+
+	this->_output(trailer, sizeof(trailer));
+
+	this->_isFinished = true;
+
+}
+
+void lz4::Encoder::_block(
+	const uint8_t* bytes,
+	size_t length
+) {
+
+	// Blocks that do not shrink are stored as they are.
+	size_t compressedLength = compressBlock(bytes, length, this->_compressed + 4, length - 1);
+
+	if (compressedLength == 0) {
+		uint8_t header[4];
+		_writeLE32(header, (uint32_t)length | _uncompressedFlag);
+		this->_output(header, sizeof(header));
+		this->_output(bytes, length);
+		return;
+	}
+
+	_writeLE32(this->_compressed, (uint32_t)compressedLength);
+
+	this->_output(this->_compressed, 4 + compressedLength);
+
+}
+
+lz4::Decoder::Decoder(
+	const Output& output
+) : _output(output),
+	_state(State::magic),
+	_headerLength(0),
+	_needed(4),
+	_position(0),
+	_skip(0),
+	_isIndependent(true),
+	_hasBlockChecksum(false),
+	_hasContentChecksum(false),
+	_hasContentSize(false),
+	_contentSize(0),
+	_produced(0),
+	_blockMaximumSize(0),
+	_blockLength(0),
+	_isBlockCompressed(false),
+	_blockChecksum(0),
+	_input(nullptr),
+	_inputLength(0),
+	_window(nullptr),
+	_windowLength(0),
+	_windowCapacity(0) { }
+
+lz4::Decoder::~Decoder() {
+	free(this->_input);
+	free(this->_window);
+}
+
+void lz4::Decoder::write(
+	const uint8_t* bytes,
+	size_t length
+) noexcept(false) {
+
+	while (length > 0) {
+
+		size_t count;
+
+		switch (this->_state) {
+			case State::skippable:
+				count = math::min(this->_skip, length);
+				this->_skip -= count;
+				this->_position += count;
+				if (this->_skip == 0) this->_expect(State::magic, 4);
+				break;
+			case State::block:
+				if (this->_inputLength == 0 && length >= this->_blockLength) {
+					count = this->_blockLength;
+					this->_position += count;
+					this->_block(bytes);
+					break;
+				}
+				count = math::min(this->_blockLength - this->_inputLength, length);
+				memcpy(this->_input + this->_inputLength, bytes, count);
+				this->_inputLength += count;
+				this->_position += count;
+				if (this->_inputLength == this->_blockLength) this->_block(this->_input);
+				break;
+			default:
+				count = math::min(this->_needed - this->_headerLength, length);
+				memcpy(this->_header + this->_headerLength, bytes, count);
+				this->_headerLength += count;
+				this->_position += count;
+				if (this->_headerLength == this->_needed) this->_parse();
+				break;
+		}
+
+		bytes += count;
+		length -= count;
+
+	}
+
+}
+
+bool lz4::Decoder::isFinished() const {
+	return this->_position > 0 && this->_state == State::magic && this->_headerLength == 0;
+}
+
+void lz4::Decoder::_expect(
+	State state,
+	size_t needed
+) {
+	this->_state = state;
+	this->_needed = needed;
+	this->_headerLength = 0;
+}
+
+void lz4::Decoder::_parse() noexcept(false) {
+
+	size_t start = this->_position - this->_headerLength;
+
+	switch (this->_state) {
+		case State::magic: {
+			uint32_t magic = _readLE32(this->_header);
+			if (magic == _frameMagic) return this->_expect(State::descriptor, 2);
+			if ((magic & 0xFFFFFFF0) == _skippableMagic) return this->_expect(State::skippableLength, 4);
+			throw MalformedCompressedDataException(start);
+		}
+		case State::descriptor: {
+
+			uint8_t flags = this->_header[0];
+			uint8_t blockDescriptor = this->_header[1];
+
+			if (this->_needed == 2) {
+				// Only version 01 without dictionaries and reserved bits is supported.
+				if ((flags & 0xC3) != 0x40 || (blockDescriptor & 0x8F) != 0 || (blockDescriptor >> 4) < 4) {
+					throw MalformedCompressedDataException(start);
+				}
+				this->_needed = 2 + ((flags & 0x08) != 0 ? 8 : 0) + 1;
+				return;
+			}
+
+			if ((uint8_t)(checksum::XXHash32::compute(this->_header, this->_needed - 1) >> 8) != this->_header[this->_needed - 1]) {
+				throw MalformedCompressedDataException(start);
+			}
+
+			this->_isIndependent = (flags & 0x20) != 0;
+			this->_hasBlockChecksum = (flags & 0x10) != 0;
+			this->_hasContentSize = (flags & 0x08) != 0;
+			this->_hasContentChecksum = (flags & 0x04) != 0;
+			this->_contentSize = this->_hasContentSize ? _readLE64(this->_header + 2) : 0;
+			this->_produced = 0;
+			this->_blockMaximumSize = (size_t)1 << (8 + 2 * (blockDescriptor >> 4));
+			this->_input = (uint8_t*)realloc(this->_input, this->_blockMaximumSize);
+			// Linked blocks may reference up to 64 KB of earlier output.
+			this->_windowCapacity = this->_blockMaximumSize + (this->_isIndependent ? 0 : _maximumDistance + 1);
+			this->_window = (uint8_t*)realloc(this->_window, this->_windowCapacity);
+			this->_windowLength = 0;
+			this->_checksum = checksum::XXHash32();
+
+			return this->_expect(State::blockLength, 4);
+
+		}
+		case State::skippableLength:
+			this->_skip = _readLE32(this->_header);
+			if (this->_skip == 0) return this->_expect(State::magic, 4);
+			return this->_expect(State::skippable, 0);
+		case State::blockLength: {
+
+			uint32_t value = _readLE32(this->_header);
+
+			if (value == 0) {
+				if (this->_hasContentSize && this->_produced != this->_contentSize) throw MalformedCompressedDataException(start);
+				if (this->_hasContentChecksum) return this->_expect(State::contentChecksum, 4);
+				return this->_expect(State::magic, 4);
+			}
+
+			this->_isBlockCompressed = (value & _uncompressedFlag) == 0;
+			this->_blockLength = value & ~_uncompressedFlag;
+			this->_inputLength = 0;
+
+			if (this->_blockLength > this->_blockMaximumSize) throw MalformedCompressedDataException(start);
+
+			return this->_expect(State::block, 0);
+
+		}
+		case State::blockChecksum:
+			if (_readLE32(this->_header) != this->_blockChecksum) throw MalformedCompressedDataException(start);
+			return this->_expect(State::blockLength, 4);
+		case State::contentChecksum:
+			if (_readLE32(this->_header) != this->_checksum.value()) throw MalformedCompressedDataException(start);
+			return this->_expect(State::magic, 4);
+		default:
+			break;
+	}
+
+}
+
+void lz4::Decoder::_block(
+	const uint8_t* bytes
+) noexcept(false) {
+
+	size_t start = this->_position - this->_blockLength;
+
+	if (this->_hasBlockChecksum) this->_blockChecksum = checksum::XXHash32::compute(bytes, this->_blockLength);
+
+	const uint8_t* result = bytes;
+	size_t length = this->_blockLength;
+
+	if (this->_isIndependent) {
+		this->_windowLength = 0;
+	} else if (this->_windowLength + this->_blockMaximumSize > this->_windowCapacity) {
+		size_t keep = math::min(this->_windowLength, _maximumDistance + 1);
+		memmove(this->_window, this->_window + this->_windowLength - keep, keep);
+		this->_windowLength = keep;
+	}
+
+	uint8_t* destination = this->_window + this->_windowLength;
+
+	if (this->_isBlockCompressed) {
+		try {
+			length = decompressBlock(bytes, this->_blockLength, destination, this->_blockMaximumSize, this->_windowLength);
+		} catch (const MalformedCompressedDataException& exception) {
+			throw MalformedCompressedDataException(start + exception.position());
+		}
+		result = destination;
+	} else if (!this->_isIndependent) {
+		memcpy(destination, bytes, length);
+		result = destination;
+	}
+
+	this->_windowLength += length;
+	this->_produced += length;
+
+	if (this->_hasContentChecksum) this->_checksum.update(result, length);
+
+	this->_inputLength = 0;
+
+	if (this->_hasBlockChecksum) this->_expect(State::blockChecksum, 4);
+	else this->_expect(State::blockLength, 4);
+
+	this->_output(result, length);
+
+}
@@ -0,0 +1,172 @@
+//
+// lz4.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_lz4_hpp
+#define foundation_lz4_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "./checksum.hpp"
+
+#define FOUNDATION_LZ4_HASH_LOG 12
+
+namespace foundation::tools::lz4 {
+
+	// Blocks and frames are compatible with the reference LZ4 implementation,
+	// so data can be exchanged with the `lz4` command line tool.
+
+	enum class BlockSize {
+		size64KB = 4,
+		size256KB,
+		size1MB,
+		size4MB
+	};
+
+	using Output = std::function<void(const uint8_t* bytes, size_t length)>;
+
+	// The largest size `length` bytes can compress to.
+	size_t blockBound(
+		size_t length);
+
+	// Returns the compressed length, or zero if it does not fit into `destinationCapacity`.
+	size_t compressBlock(
+		const uint8_t* source,
+		size_t sourceLength,
+		uint8_t* destination,
+		size_t destinationCapacity);
+
+	// Returns the decompressed length. Matches may reference the `prefixLength`
+	// bytes right in front of `destination` (linked blocks).
+	size_t decompressBlock(
+		const uint8_t* source,
+		size_t sourceLength,
+		uint8_t* destination,
+		size_t destinationCapacity,
+		size_t prefixLength = 0
+	) noexcept(false);
+
+	// Compresses input into a frame of independent blocks with a content checksum.
+	// Input can be written in pieces of any size, and output is handed over as
+	// soon as a block is complete. `finish` must be called to end the frame.
+	class Encoder {
+
+		public:
+
+			Encoder(
+				const Output& output,
+				BlockSize blockSize = BlockSize::size256KB);
+
+			Encoder(const Encoder& other) = delete;
+			Encoder(Encoder&& other) = delete;
+
+			~Encoder();
+
+			Encoder& operator=(const Encoder& other) = delete;
+
+			void write(
+				const uint8_t* bytes,
+				size_t length
+			) noexcept(false);
+
+			void finish() noexcept(false);
+
+		private:
+
+			Output _output;
+			size_t _blockSize;
+			uint8_t* _buffer;
+			size_t _bufferLength;
+			uint8_t* _compressed;
+			checksum::XXHash32 _checksum;
+			bool _isFinished;
+
+			void _block(
+				const uint8_t* bytes,
+				size_t length);
+
+	};
+
+	// Decompresses one or more concatenated frames written in pieces of any size.
+	// Independent and linked blocks, block checksums, content sizes and skippable
+	// frames are supported. Dictionaries are not.
+	class Decoder {
+
+		public:
+
+			Decoder(
+				const Output& output);
+
+			Decoder(const Decoder& other) = delete;
+			Decoder(Decoder&& other) = delete;
+
+			~Decoder();
+
+			Decoder& operator=(const Decoder& other) = delete;
+
+			void write(
+				const uint8_t* bytes,
+				size_t length
+			) noexcept(false);
+
+			// Returns true when all input written so far makes up complete frames.
+			bool isFinished() const;
+
+		private:
+
+			enum class State {
+				magic = 0,
+				descriptor,
+				skippableLength,
+				skippable,
+				blockLength,
+				block,
+				blockChecksum,
+				contentChecksum
+			};
+
+			Output _output;
+			State _state;
+			uint8_t _header[16];
+			size_t _headerLength;
+			size_t _needed;
+			size_t _position;
+			size_t _skip;
+			bool _isIndependent;
+			bool _hasBlockChecksum;
+			bool _hasContentChecksum;
+			bool _hasContentSize;
+			uint64_t _contentSize;
+			uint64_t _produced;
+			size_t _blockMaximumSize;
+			size_t _blockLength;
+			bool _isBlockCompressed;
+			uint32_t _blockChecksum;
+			uint8_t* _input;
+			size_t _inputLength;
+			uint8_t* _window;
+			size_t _windowLength;
+			size_t _windowCapacity;
+			checksum::XXHash32 _checksum;
+
+			void _expect(
+				State state,
+				size_t needed);
+
+			void _parse() noexcept(false);
+
+			void _block(
+				const uint8_t* bytes) noexcept(false);
+
+	};
+
+}
+
+#endif /* foundation_lz4_hpp */
@@ -0,0 +1,217 @@
+//
+// multi-search.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_multi_search_hpp
+#define foundation_multi_search_hpp
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <concepts>
+
+#include "./math.hpp"
+#include "./search.hpp"
+
+namespace foundation::tools {
+
+	// Finds several patterns in one pass over the haystack (Aho-Corasick).
+	// Byte patterns are compiled to a full transition table, wider items follow
+	// failure links. When no match is in progress, the scan skips ahead to the
+	// next item that can start a pattern using `search::findAny`.
+	template<typename T>
+	class MultiSearch {
+
+	public:
+
+		static const size_t NotFound = math::limit<size_t>();
+
+		struct Match {
+			size_t index;
+			size_t length;
+			size_t pattern;
+		};
+
+		// `pattern(idx)` must return something with `items()` and `length()`.
+		// Empty patterns are ignored.
+		template<typename F>
+		requires std::invocable<F&, size_t>
+		MultiSearch(size_t count, F&& pattern) : _nodes(nullptr), _count(0), _capacity(0), _table(nullptr), _firstsLength(0) {
+			this->_node(T(), 0);
+			for (size_t idx = 0 ; idx < count ; idx++) {
+				auto current = pattern(idx);
+				this->_add(current.items(), current.length(), idx);
+			}
+			this->_compile();
+		}
+
+		MultiSearch(const MultiSearch<T>& other) = delete;
+		MultiSearch(MultiSearch<T>&& other) = delete;
+
+		~MultiSearch() {
+			free(this->_nodes);
+			free(this->_table);
+		}
+
+		MultiSearch<T>& operator=(const MultiSearch<T>& other) = delete;
+
+		// Returns the leftmost match at or after `offset`. When several patterns
+		// start at the same index, the longest one wins. The index of the match is
+		// `NotFound` if there is none.
+		Match find(const T* haystack, size_t haystackLength, size_t offset = 0) const {
+
+			Match result = { NotFound, 0, NotFound };
+
+			if (this->_count == 1) return result;
+
+			size_t state = 0;
+
+			for (size_t index = offset ; index < haystackLength ; index++) {
+
+				if (state == 0 && this->_firstsLength > 0) {
+					size_t next = search::findAny(haystack + index, haystackLength - index, this->_firsts, this->_firstsLength);
+					if (next == NotFound) break;
+					index += next;
+				}
+
+				state = this->_transition(state, haystack[index]);
+
+				size_t output = this->_nodes[state].output;
+
+				if (output != NotFound) {
+					size_t length = this->_nodes[output].depth;
+					size_t start = index + 1 - length;
+					if (result.index == NotFound || start < result.index || (start == result.index && length > result.length)) {
+						result = { start, length, this->_nodes[output].pattern };
+					}
+				}
+
+				// No match that is still in progress can start at or before the one found.
+				if (result.index != NotFound && index + 1 - this->_nodes[state].depth > result.index) break;
+
+			}
+
+			return result;
+
+		}
+
+	private:
+
+		struct Node {
+			T symbol;
+			size_t child;
+			size_t sibling;
+			size_t failure;
+			size_t output;
+			size_t depth;
+			size_t pattern;
+		};
+
+		static constexpr bool _isDense = sizeof(T) == 1;
+
+		Node* _nodes;
+		size_t _count;
+		size_t _capacity;
+		uint32_t* _table;
+		T _firsts[FOUNDATION_SEARCH_ANY_LIMIT];
+		size_t _firstsLength;
+
+		size_t _node(T symbol, size_t depth) {
+			if (this->_count == this->_capacity) {
+				this->_capacity = math::max<size_t>(16, this->_capacity * 2);
+				this->_nodes = (Node*)realloc(this->_nodes, sizeof(Node) * this->_capacity);
+			}
+			this->_nodes[this->_count] = { symbol, NotFound, NotFound, 0, NotFound, depth, NotFound };
+			return this->_count++;
+		}
+
+		size_t _child(size_t state, T symbol) const {
+			for (size_t child = this->_nodes[state].child ; child != NotFound ; child = this->_nodes[child].sibling) {
+				if (this->_nodes[child].symbol == symbol) return child;
+			}
+			return NotFound;
+		}
+
+		void _add(const T* items, size_t length, size_t pattern) {
+			if (length == 0) return;
+			size_t state = 0;
+			for (size_t idx = 0 ; idx < length ; idx++) {
+				size_t child = this->_child(state, items[idx]);
+				if (child == NotFound) {
+					child = this->_node(items[idx], idx + 1);
+					this->_nodes[child].sibling = this->_nodes[state].child;
+					this->_nodes[state].child = child;
+				}
+				state = child;
+			}
+			if (this->_nodes[state].pattern == NotFound) this->_nodes[state].pattern = pattern;
+		}
+
+		void _compile() {
+
+			size_t* queue = (size_t*)malloc(sizeof(size_t) * this->_count);
+			size_t head = 0;
+			size_t tail = 0;
+
+			if constexpr (_isDense) {
+				this->_table = (uint32_t*)calloc(this->_count * 256, sizeof(uint32_t));
+			}
+
+			size_t firsts = 0;
+
+			for (size_t child = this->_nodes[0].child ; child != NotFound ; child = this->_nodes[child].sibling) {
+				queue[tail++] = child;
+				if (firsts < FOUNDATION_SEARCH_ANY_LIMIT) this->_firsts[firsts] = this->_nodes[child].symbol;
+				firsts++;
+				if constexpr (_isDense) this->_table[(uint8_t)this->_nodes[child].symbol] = (uint32_t)child;
+			}
+
+			// Too many starting items for the filter to pay off.
+			this->_firstsLength = firsts <= FOUNDATION_SEARCH_ANY_LIMIT ? firsts : 0;
+
+			while (head < tail) {
+
+				size_t state = queue[head++];
+				Node& node = this->_nodes[state];
+
+				node.output = node.pattern != NotFound ? state : this->_nodes[node.failure].output;
+
+				if constexpr (_isDense) {
+					memcpy(&this->_table[state * 256], &this->_table[node.failure * 256], sizeof(uint32_t) * 256);
+				}
+
+				for (size_t child = node.child ; child != NotFound ; child = this->_nodes[child].sibling) {
+					this->_nodes[child].failure = this->_transition(node.failure, this->_nodes[child].symbol);
+					if constexpr (_isDense) this->_table[state * 256 + (uint8_t)this->_nodes[child].symbol] = (uint32_t)child;
+					queue[tail++] = child;
+				}
+
+			}
+
+			free(queue);
+
+		}
+
+		inline size_t _transition(size_t state, T symbol) const {
+			if constexpr (_isDense) {
+				return this->_table[state * 256 + (uint8_t)symbol];
+			} else {
+				while (true) {
+					size_t child = this->_child(state, symbol);
+					if (child != NotFound) return child;
+					if (state == 0) return 0;
+					state = this->_nodes[state].failure;
+				}
+			}
+		}
+
+	};
+
+}
+
+#endif /* foundation_multi_search_hpp */
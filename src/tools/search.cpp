@@ -0,0 +1,564 @@
+//
+// search.cpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#include <string.h>
+#include <sys/types.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FOUNDATION_SEARCH_X86
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define FOUNDATION_SEARCH_NEON
+#endif
+
+#include "./search.hpp"
+
+using namespace foundation::tools;
+
+#define NOT_FOUND math::limit<size_t>()
+
+template<typename T>
+static inline bool _matches(
+	const T* haystack,
+	const T* needle,
+	size_t needleLength
+) {
+	// First and last elements have already been compared by the filters.
+	return needleLength <= 2 || memcmp(haystack + 1, needle + 1, (needleLength - 2) * sizeof(T)) == 0;
+}
+
+template<typename T>
+static size_t _scalar(
+	const T* haystack,
+	size_t haystackLength,
+	const T* needle,
+	size_t needleLength,
+	size_t index
+) {
+	for ( ; index <= haystackLength - needleLength ; index++) {
+		if (haystack[index] == needle[0] && haystack[index + needleLength - 1] == needle[needleLength - 1] && _matches(haystack + index, needle, needleLength)) {
+			return index;
+		}
+	}
+	return NOT_FOUND;
+}
+
+template<typename T>
+static size_t _scalarAny(
+	const T* haystack,
+	size_t haystackLength,
+	const T* set,
+	size_t setLength,
+	size_t index
+) {
+	for ( ; index < haystackLength ; index++) {
+		for (size_t idx = 0 ; idx < setLength ; idx++) {
+			if (haystack[index] == set[idx]) return index;
+		}
+	}
+	return NOT_FOUND;
+}
+
+// Crochemore-Perrin Two-Way. Linear time and constant space.
+template<typename T>
+static ssize_t _maximalSuffix(
+	const T* needle,
+	ssize_t needleLength,
+	ssize_t* period,
+	bool reversed
+) {
+
+	ssize_t suffix = -1;
+	ssize_t j = 0;
+	ssize_t k = 1;
+
+	*period = 1;
+
+	while (j + k < needleLength) {
+		T a = needle[j + k];
+		T b = needle[suffix + k];
+		if (reversed ? a > b : a < b) {
+			j += k;
+			k = 1;
+			*period = j - suffix;
+		} else if (a == b) {
+			if (k != *period) {
+				k++;
+			} else {
+				j += *period;
+				k = 1;
+			}
+		} else {
+			suffix = j;
+			j = suffix + 1;
+			k = *period = 1;
+		}
+	}
+
+	return suffix;
+
+}
+
+template<typename T>
+static size_t _twoWay(
+	const T* haystack,
+	size_t haystackLength,
+	const T* needle,
+	size_t needleLength
+) {
+
+	ssize_t n = (ssize_t)haystackLength;
+	ssize_t m = (ssize_t)needleLength;
+
+	ssize_t period;
+	ssize_t reversedPeriod;
+	ssize_t suffix = _maximalSuffix(needle, m, &period, false);
+	ssize_t reversedSuffix = _maximalSuffix(needle, m, &reversedPeriod, true);
+
+	ssize_t critical = suffix;
+
+	if (reversedSuffix > suffix) {
+		critical = reversedSuffix;
+		period = reversedPeriod;
+	}
+
+	if (memcmp(needle, needle + period, (size_t)(critical + 1) * sizeof(T)) == 0) {
+
+		ssize_t memory = -1;
+
+		for (ssize_t j = 0 ; j <= n - m ; ) {
+			ssize_t i = math::max(critical, memory) + 1;
+			while (i < m && needle[i] == haystack[i + j]) i++;
+			if (i >= m) {
+				i = critical;
+				while (i > memory && needle[i] == haystack[i + j]) i--;
+				if (i <= memory) return (size_t)j;
+				j += period;
+				memory = m - period - 1;
+			} else {
+				j += i - critical;
+				memory = -1;
+			}
+		}
+
+	} else {
+
+		period = math::max(critical + 1, m - critical - 1) + 1;
+
+		for (ssize_t j = 0 ; j <= n - m ; ) {
+			ssize_t i = critical + 1;
+			while (i < m && needle[i] == haystack[i + j]) i++;
+			if (i >= m) {
+				i = critical;
+				while (i >= 0 && needle[i] == haystack[i + j]) i--;
+				if (i < 0) return (size_t)j;
+				j += period;
+			} else {
+				j += i - critical;
+			}
+		}
+
+	}
+
+	return NOT_FOUND;
+
+}
+
+#if defined(FOUNDATION_SEARCH_X86)
+
+template<typename T>
+static size_t _sse2(
+	const T* haystack,
+	size_t haystackLength,
+	const T* needle,
+	size_t needleLength
+) {
+
+	constexpr size_t lanes = 16 / sizeof(T);
+
+	__m128i first;
+	__m128i last;
+
+	if constexpr (sizeof(T) == 1) {
+		first = _mm_set1_epi8((char)needle[0]);
+		last = _mm_set1_epi8((char)needle[needleLength - 1]);
+	} else if constexpr (sizeof(T) == 2) {
+		first = _mm_set1_epi16((short)needle[0]);
+		last = _mm_set1_epi16((short)needle[needleLength - 1]);
+	} else {
+		first = _mm_set1_epi32((int)needle[0]);
+		last = _mm_set1_epi32((int)needle[needleLength - 1]);
+	}
+
+	size_t index = 0;
+
+	for ( ; index + lanes + needleLength - 1 <= haystackLength ; index += lanes) {
+
+		__m128i blockFirst = _mm_loadu_si128((const __m128i*)(haystack + index));
+		__m128i blockLast = _mm_loadu_si128((const __m128i*)(haystack + index + needleLength - 1));
+
+		__m128i equal;
+
+		if constexpr (sizeof(T) == 1) {
+			equal = _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last));
+		} else if constexpr (sizeof(T) == 2) {
+			equal = _mm_and_si128(_mm_cmpeq_epi16(blockFirst, first), _mm_cmpeq_epi16(blockLast, last));
+		} else {
+			equal = _mm_and_si128(_mm_cmpeq_epi32(blockFirst, first), _mm_cmpeq_epi32(blockLast, last));
+		}
+
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(equal);
+
+		while (mask != 0) {
+			uint32_t bit = (uint32_t)__builtin_ctz(mask);
+			size_t candidate = index + bit / sizeof(T);
+			if (_matches(haystack + candidate, needle, needleLength)) return candidate;
+			mask &= ~(((1u << sizeof(T)) - 1) << bit);
+		}
+
+	}
+
+	return _scalar(haystack, haystackLength, needle, needleLength, index);
+
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+static size_t _avx2(
+	const T* haystack,
+	size_t haystackLength,
+	const T* needle,
+	size_t needleLength
+) {
+
+	constexpr size_t lanes = 32 / sizeof(T);
+
+	__m256i first;
+	__m256i last;
+
+	if constexpr (sizeof(T) == 1) {
+		first = _mm256_set1_epi8((char)needle[0]);
+		last = _mm256_set1_epi8((char)needle[needleLength - 1]);
+	} else if constexpr (sizeof(T) == 2) {
+		first = _mm256_set1_epi16((short)needle[0]);
+		last = _mm256_set1_epi16((short)needle[needleLength - 1]);
+	} else {
+		first = _mm256_set1_epi32((int)needle[0]);
+		last = _mm256_set1_epi32((int)needle[needleLength - 1]);
+	}
+
+	size_t index = 0;
+
+	for ( ; index + lanes + needleLength - 1 <= haystackLength ; index += lanes) {
+
+		__m256i blockFirst = _mm256_loadu_si256((const __m256i*)(haystack + index));
+		__m256i blockLast = _mm256_loadu_si256((const __m256i*)(haystack + index + needleLength - 1));
+
+		__m256i equal;
+
+		if constexpr (sizeof(T) == 1) {
+			equal = _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last));
+		} else if constexpr (sizeof(T) == 2) {
+			equal = _mm256_and_si256(_mm256_cmpeq_epi16(blockFirst, first), _mm256_cmpeq_epi16(blockLast, last));
+		} else {
+			equal = _mm256_and_si256(_mm256_cmpeq_epi32(blockFirst, first), _mm256_cmpeq_epi32(blockLast, last));
+		}
+
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(equal);
+
+		while (mask != 0) {
+			uint32_t bit = (uint32_t)__builtin_ctz(mask);
+			size_t candidate = index + bit / sizeof(T);
+			if (_matches(haystack + candidate, needle, needleLength)) return candidate;
+			mask &= ~((uint32_t)(((uint64_t)1 << sizeof(T)) - 1) << bit);
+		}
+
+	}
+
+	return _scalar(haystack, haystackLength, needle, needleLength, index);
+
+}
+
+template<typename T>
+static size_t _sse2Any(
+	const T* haystack,
+	size_t haystackLength,
+	const T* set,
+	size_t setLength
+) {
+
+	constexpr size_t lanes = 16 / sizeof(T);
+
+	__m128i needles[FOUNDATION_SEARCH_ANY_LIMIT];
+
+	for (size_t idx = 0 ; idx < setLength ; idx++) {
+		if constexpr (sizeof(T) == 1) needles[idx] = _mm_set1_epi8((char)set[idx]);
+		else if constexpr (sizeof(T) == 2) needles[idx] = _mm_set1_epi16((short)set[idx]);
+		else needles[idx] = _mm_set1_epi32((int)set[idx]);
+	}
+
+	size_t index = 0;
+
+	for ( ; index + lanes <= haystackLength ; index += lanes) {
+
+		__m128i block = _mm_loadu_si128((const __m128i*)(haystack + index));
+		__m128i equal = _mm_setzero_si128();
+
+		for (size_t idx = 0 ; idx < setLength ; idx++) {
+			if constexpr (sizeof(T) == 1) equal = _mm_or_si128(equal, _mm_cmpeq_epi8(block, needles[idx]));
+			else if constexpr (sizeof(T) == 2) equal = _mm_or_si128(equal, _mm_cmpeq_epi16(block, needles[idx]));
+			else equal = _mm_or_si128(equal, _mm_cmpeq_epi32(block, needles[idx]));
+		}
+
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(equal);
+
+		if (mask != 0) return index + (size_t)__builtin_ctz(mask) / sizeof(T);
+
+	}
+
+	return _scalarAny(haystack, haystackLength, set, setLength, index);
+
+}
+
+template<typename T>
+__attribute__((target("avx2")))
+static size_t _avx2Any(
+	const T* haystack,
+	size_t haystackLength,
+	const T* set,
+	size_t setLength
+) {
+
+	constexpr size_t lanes = 32 / sizeof(T);
+
+	__m256i needles[FOUNDATION_SEARCH_ANY_LIMIT];
+
+	for (size_t idx = 0 ; idx < setLength ; idx++) {
+		if constexpr (sizeof(T) == 1) needles[idx] = _mm256_set1_epi8((char)set[idx]);
+		else if constexpr (sizeof(T) == 2) needles[idx] = _mm256_set1_epi16((short)set[idx]);
+		else needles[idx] = _mm256_set1_epi32((int)set[idx]);
+	}
+
+	size_t index = 0;
+
+	for ( ; index + lanes <= haystackLength ; index += lanes) {
+
+		__m256i block = _mm256_loadu_si256((const __m256i*)(haystack + index));
+		__m256i equal = _mm256_setzero_si256();
+
+		for (size_t idx = 0 ; idx < setLength ; idx++) {
+			if constexpr (sizeof(T) == 1) equal = _mm256_or_si256(equal, _mm256_cmpeq_epi8(block, needles[idx]));
+			else if constexpr (sizeof(T) == 2) equal = _mm256_or_si256(equal, _mm256_cmpeq_epi16(block, needles[idx]));
+			else equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(block, needles[idx]));
+		}
+
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(equal);
+
+		if (mask != 0) return index + (size_t)__builtin_ctz(mask) / sizeof(T);
+
+	}
+
+	return _scalarAny(haystack, haystackLength, set, setLength, index);
+
+}
+
+static inline bool _hasAVX2() {
+	static const bool result = __builtin_cpu_supports("avx2");
+	return result;
+}
+
+#elif defined(FOUNDATION_SEARCH_NEON)
+
+template<typename T>
+static size_t _neon(
+	const T* haystack,
+	size_t haystackLength,
+	const T* needle,
+	size_t needleLength
+) {
+
+	constexpr size_t lanes = 16 / sizeof(T);
+
+	size_t index = 0;
+
+	for ( ; index + lanes + needleLength - 1 <= haystackLength ; index += lanes) {
+
+		uint8x16_t equal;
+
+		if constexpr (sizeof(T) == 1) {
+			equal = vandq_u8(
+				vceqq_u8(vld1q_u8((const uint8_t*)haystack + index), vdupq_n_u8((uint8_t)needle[0])),
+				vceqq_u8(vld1q_u8((const uint8_t*)haystack + index + needleLength - 1), vdupq_n_u8((uint8_t)needle[needleLength - 1])));
+		} else if constexpr (sizeof(T) == 2) {
+			equal = vreinterpretq_u8_u16(vandq_u16(
+				vceqq_u16(vld1q_u16((const uint16_t*)haystack + index), vdupq_n_u16((uint16_t)needle[0])),
+				vceqq_u16(vld1q_u16((const uint16_t*)haystack + index + needleLength - 1), vdupq_n_u16((uint16_t)needle[needleLength - 1]))));
+		} else {
+			equal = vreinterpretq_u8_u32(vandq_u32(
+				vceqq_u32(vld1q_u32((const uint32_t*)haystack + index), vdupq_n_u32((uint32_t)needle[0])),
+				vceqq_u32(vld1q_u32((const uint32_t*)haystack + index + needleLength - 1), vdupq_n_u32((uint32_t)needle[needleLength - 1]))));
+		}
+
+		// Four bits per byte.
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+
+		while (mask != 0) {
+			size_t lane = (size_t)__builtin_ctzll(mask) / (4 * sizeof(T));
+			size_t candidate = index + lane;
+			if (_matches(haystack + candidate, needle, needleLength)) return candidate;
+			mask &= ~((((uint64_t)1 << (4 * sizeof(T))) - 1) << (lane * 4 * sizeof(T)));
+		}
+
+	}
+
+	return _scalar(haystack, haystackLength, needle, needleLength, index);
+
+}
+
+template<typename T>
+static size_t _neonAny(
+	const T* haystack,
+	size_t haystackLength,
+	const T* set,
+	size_t setLength
+) {
+
+	constexpr size_t lanes = 16 / sizeof(T);
+
+	size_t index = 0;
+
+	for ( ; index + lanes <= haystackLength ; index += lanes) {
+
+		uint8x16_t equal = vdupq_n_u8(0);
+
+		for (size_t idx = 0 ; idx < setLength ; idx++) {
+			if constexpr (sizeof(T) == 1) {
+				equal = vorrq_u8(equal, vceqq_u8(vld1q_u8((const uint8_t*)haystack + index), vdupq_n_u8((uint8_t)set[idx])));
+			} else if constexpr (sizeof(T) == 2) {
+				equal = vorrq_u8(equal, vreinterpretq_u8_u16(vceqq_u16(vld1q_u16((const uint16_t*)haystack + index), vdupq_n_u16((uint16_t)set[idx]))));
+			} else {
+				equal = vorrq_u8(equal, vreinterpretq_u8_u32(vceqq_u32(vld1q_u32((const uint32_t*)haystack + index), vdupq_n_u32((uint32_t)set[idx]))));
+			}
+		}
+
+		// Four bits per byte.
+		uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+
+		if (mask != 0) return index + (size_t)__builtin_ctzll(mask) / (4 * sizeof(T));
+
+	}
+
+	return _scalarAny(haystack, haystackLength, set, setLength, index);
+
+}
+
+#endif
+
+template<typename T>
+static inline size_t _find(
+	const T* haystack,
+	size_t haystackLength,
+	const T* needle,
+	size_t needleLength
+) {
+
+	if (needleLength == 0) return 0;
+	if (needleLength > haystackLength) return NOT_FOUND;
+
+	if (needleLength >= FOUNDATION_SEARCH_TWO_WAY_THRESHOLD) {
+		return _twoWay(haystack, haystackLength, needle, needleLength);
+	}
+
+#if defined(FOUNDATION_SEARCH_X86)
+	if (_hasAVX2()) return _avx2(haystack, haystackLength, needle, needleLength);
+	return _sse2(haystack, haystackLength, needle, needleLength);
+#elif defined(FOUNDATION_SEARCH_NEON)
+	return _neon(haystack, haystackLength, needle, needleLength);
+#else
+	return _scalar(haystack, haystackLength, needle, needleLength, 0);
+#endif
+
+}
+
+size_t search::find(
+	const uint8_t* haystack,
+	size_t haystackLength,
+	const uint8_t* needle,
+	size_t needleLength
+) {
+	return _find(haystack, haystackLength, needle, needleLength);
+}
+
+size_t search::find(
+	const uint16_t* haystack,
+	size_t haystackLength,
+	const uint16_t* needle,
+	size_t needleLength
+) {
+	return _find(haystack, haystackLength, needle, needleLength);
+}
+
+size_t search::find(
+	const uint32_t* haystack,
+	size_t haystackLength,
+	const uint32_t* needle,
+	size_t needleLength
+) {
+	return _find(haystack, haystackLength, needle, needleLength);
+}
+
+template<typename T>
+static inline size_t _findAny(
+	const T* haystack,
+	size_t haystackLength,
+	const T* set,
+	size_t setLength
+) {
+
+	if (setLength == 0 || setLength > FOUNDATION_SEARCH_ANY_LIMIT) {
+		return _scalarAny(haystack, haystackLength, set, setLength, 0);
+	}
+
+#if defined(FOUNDATION_SEARCH_X86)
+	if (_hasAVX2()) return _avx2Any(haystack, haystackLength, set, setLength);
+	return _sse2Any(haystack, haystackLength, set, setLength);
+#elif defined(FOUNDATION_SEARCH_NEON)
+	return _neonAny(haystack, haystackLength, set, setLength);
+#else
+	return _scalarAny(haystack, haystackLength, set, setLength, 0);
+#endif
+
+}
+
+size_t search::findAny(
+	const uint8_t* haystack,
+	size_t haystackLength,
+	const uint8_t* set,
+	size_t setLength
+) {
+	return _findAny(haystack, haystackLength, set, setLength);
+}
+
+size_t search::findAny(
+	const uint16_t* haystack,
+	size_t haystackLength,
+	const uint16_t* set,
+	size_t setLength
+) {
+	return _findAny(haystack, haystackLength, set, setLength);
+}
+
+size_t search::findAny(
+	const uint32_t* haystack,
+	size_t haystackLength,
+	const uint32_t* set,
+	size_t setLength
+) {
+	return _findAny(haystack, haystackLength, set, setLength);
+}
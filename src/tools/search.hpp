@@ -0,0 +1,151 @@
+//
+// search.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_search_hpp
+#define foundation_search_hpp
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <type_traits>
+
+#include "./math.hpp"
+
+#define FOUNDATION_SEARCH_TWO_WAY_THRESHOLD 32
+#define FOUNDATION_SEARCH_ANY_LIMIT 8
+
+namespace foundation::tools {
+
+	namespace search {
+
+		// Returns the index of the first occurrence of `needle` in `haystack`, or
+		// `math::limit<size_t>()` if there is none. Short needles are found with
+		// a vectorized first/last element filter, long needles with the Two-Way
+		// algorithm.
+		size_t find(
+			const uint8_t* haystack,
+			size_t haystackLength,
+			const uint8_t* needle,
+			size_t needleLength);
+
+		size_t find(
+			const uint16_t* haystack,
+			size_t haystackLength,
+			const uint16_t* needle,
+			size_t needleLength);
+
+		size_t find(
+			const uint32_t* haystack,
+			size_t haystackLength,
+			const uint32_t* needle,
+			size_t needleLength);
+
+		template<typename T>
+		inline size_t find(
+			const T* haystack,
+			size_t haystackLength,
+			const T* needle,
+			size_t needleLength
+		) {
+
+			if constexpr (std::is_integral<T>::value && sizeof(T) == 1) {
+				return find((const uint8_t*)haystack, haystackLength, (const uint8_t*)needle, needleLength);
+			} else if constexpr (std::is_integral<T>::value && sizeof(T) == 2) {
+				return find((const uint16_t*)haystack, haystackLength, (const uint16_t*)needle, needleLength);
+			} else if constexpr (std::is_integral<T>::value && sizeof(T) == 4) {
+				return find((const uint32_t*)haystack, haystackLength, (const uint32_t*)needle, needleLength);
+			} else {
+
+				if (needleLength > haystackLength) return math::limit<size_t>();
+
+				for (size_t index = 0 ; index <= haystackLength - needleLength ; index++) {
+					size_t idx = 0;
+					while (idx < needleLength && haystack[index + idx] == needle[idx]) idx++;
+					if (idx == needleLength) return index;
+				}
+
+				return math::limit<size_t>();
+
+			}
+
+		}
+
+		// Returns the index of the first item in `haystack` that equals any item in
+		// `set`, or `math::limit<size_t>()` if there is none. Sets of up to
+		// `FOUNDATION_SEARCH_ANY_LIMIT` items are compared a vector at a time.
+		size_t findAny(
+			const uint8_t* haystack,
+			size_t haystackLength,
+			const uint8_t* set,
+			size_t setLength);
+
+		size_t findAny(
+			const uint16_t* haystack,
+			size_t haystackLength,
+			const uint16_t* set,
+			size_t setLength);
+
+		size_t findAny(
+			const uint32_t* haystack,
+			size_t haystackLength,
+			const uint32_t* set,
+			size_t setLength);
+
+		template<typename T>
+		inline size_t findAny(
+			const T* haystack,
+			size_t haystackLength,
+			const T* set,
+			size_t setLength
+		) {
+
+			if constexpr (std::is_integral<T>::value && sizeof(T) == 1) {
+				return findAny((const uint8_t*)haystack, haystackLength, (const uint8_t*)set, setLength);
+			} else if constexpr (std::is_integral<T>::value && sizeof(T) == 2) {
+				return findAny((const uint16_t*)haystack, haystackLength, (const uint16_t*)set, setLength);
+			} else if constexpr (std::is_integral<T>::value && sizeof(T) == 4) {
+				return findAny((const uint32_t*)haystack, haystackLength, (const uint32_t*)set, setLength);
+			} else {
+
+				for (size_t index = 0 ; index < haystackLength ; index++) {
+					for (size_t idx = 0 ; idx < setLength ; idx++) {
+						if (haystack[index] == set[idx]) return index;
+					}
+				}
+
+				return math::limit<size_t>();
+
+			}
+
+		}
+
+		template<typename T>
+		inline size_t findLast(
+			const T* haystack,
+			size_t haystackLength,
+			const T* needle,
+			size_t needleLength
+		) {
+
+			if (needleLength > haystackLength) return math::limit<size_t>();
+
+			for (size_t index = haystackLength - needleLength + 1 ; index > 0 ; index--) {
+				size_t idx = 0;
+				while (idx < needleLength && haystack[index - 1 + idx] == needle[idx]) idx++;
+				if (idx == needleLength) return index - 1;
+			}
+
+			return math::limit<size_t>();
+
+		}
+
+	}
+
+}
+
+#endif /* foundation_search_hpp */
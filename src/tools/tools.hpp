@@ -9,8 +9,14 @@
 #ifndef foundation_tools_hpp
 #define foundation_tools_hpp
 
+#include "./base64.hpp"
+#include "./checksum.hpp"
+#include "./hex.hpp"
+#include "./lz4.hpp"
 #include "./math.hpp"
+#include "./multi-search.hpp"
 #include "./queue.hpp"
 #include "./regular-expression.hpp"
+#include "./search.hpp"
 
 #endif /* foundation_tools_hpp */
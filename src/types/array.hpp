@@ -9,6 +9,7 @@
 #ifndef foundation_array_hpp
 #define foundation_array_hpp
 
+#include <concepts>
 #include <type_traits>
 #include <functional>
 
@@ -82,28 +83,51 @@ namespace foundation::types {
 
 		Array(const Data<T*>& other) : _storage(other) {
 			for (size_t idx = 0 ; idx < this->_storage.length() ; idx++) {
-				this->_storage[idx]->retain();
+				_retain(this->_storage[idx]);
 			}
 		}
 
 		Storage _storage;
 
-		static void _insertionSort(Array& array, Comparer comparer) {
+		// Taken around every change to `_storage`, so the cycle collector can read
+		// it from another thread.
+		[[no_unique_address]] CycleCollector::Lock _lock;
+
+		static inline void _retain(T* item) {
+			item->retain();
+			item->stored();
+		}
+
+		// Replaces the storage with `storage`, whose items are already retained,
+		// and releases the previous items.
+		void _exchange(Storage& storage) {
+			{
+				CycleCollector::Lock::Guard guard(_lock);
+				std::swap(_storage, storage);
+			}
+			for (size_t idx = 0 ; idx < storage.length() ; idx++) {
+				storage[idx]->release();
+			}
+		}
+
+		template<typename F>
+		static void _insertionSort(Array& array, F& comparer) {
 			for (size_t idx = 1 ; idx < array.count() ; idx++) {
 				size_t j = idx;
-				while (j > 0 && comparer(array[j - 1], array[j])) {
+				while (j > 0 && comparer(*array._storage[j - 1], *array._storage[j])) {
 					array.swapItemAtIndices(j - 1, j);
 					j--;
 				}
 			}
 		}
 
-		static void _quickSort(Array& array, const size_t& offset, const size_t& count, Comparer comparer) {
+		template<typename F>
+		static void _quickSort(Array& array, const size_t& offset, const size_t& count, F& comparer) {
 			if (count == 0) return;
 			size_t pivot = count - 1;
 			size_t idx = 0;
 			while (idx < pivot) {
-				if (comparer(array[offset + idx], array[offset + pivot])) {
+				if (comparer(*array._storage[offset + idx], *array._storage[offset + pivot])) {
 					if (idx == pivot - 1) {
 						array.swapItemAtIndices(offset + idx, offset + pivot);
 					} else {
@@ -131,7 +155,10 @@ namespace foundation::types {
 
 		Array(const Array<T>& other) : Array(other._storage) {}
 
-		Array(Array&& other) : Type(), _storage(std::move(other._storage)) { }
+		Array(Array&& other) : Type() {
+			CycleCollector::Lock::Guard guard(other._lock);
+			_storage = std::move(other._storage);
+		}
 
 		Array(Strong<T> repeatedItem, size_t count = 1) : Array() {
 			for (size_t idx = 0 ; idx < count ; idx++) {
@@ -171,12 +198,40 @@ namespace foundation::types {
 			return _storage.length();
 		}
 
-		inline size_t count(Tester tester) const {
+		inline size_t capacity() const {
+			return _storage.capacity();
+		}
+
+		inline void reserve(size_t capacity) {
+			CycleCollector::Lock::Guard guard(_lock);
+			_storage.reserve(capacity);
+		}
+
+		inline void shrinkToFit() {
+			CycleCollector::Lock::Guard guard(_lock);
+			_storage.shrinkToFit();
+		}
+
+		inline Growth growth() const {
+			return _storage.growth();
+		}
+
+		inline void setGrowth(Growth growth) {
+			_storage.setGrowth(growth);
+		}
+
+		template<typename F>
+		requires std::predicate<F&, T&>
+		size_t count(F&& tester) const {
 			return _storage.count([&tester](T* other) {
 				return tester(*other);
 			});
 		}
 
+		inline size_t count(Tester tester) const {
+			return this->count<Tester&>(tester);
+		}
+
 		inline size_t count(const T& item) const {
 			return this->count([&item](T* other) {
 				return *other == item;
@@ -192,7 +247,8 @@ namespace foundation::types {
 		}
 
 		void append(Strong<T> item) {
-			item->retain();
+			_retain(item);
+			CycleCollector::Lock::Guard guard(_lock);
 			_storage.append(item);
 		}
 
@@ -221,7 +277,12 @@ namespace foundation::types {
 		}
 
 		inline void removeItemAtIndex(const size_t& index) noexcept(false) {
-			_storage.removeItemAtIndex(index)->release();
+			T* item;
+			{
+				CycleCollector::Lock::Guard guard(_lock);
+				item = _storage.removeItemAtIndex(index);
+			}
+			item->release();
 		}
 
 		Strong<Array<T>> removingItemAtIndex(const size_t& index) const noexcept(false) {
@@ -230,7 +291,9 @@ namespace foundation::types {
 			return result;
 		}
 
-		void removeItem(const TesterIndex& test) noexcept(false) {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t> || std::predicate<F&, T&>
+		void removeItem(F&& test) noexcept(false) {
 			size_t idx = indexOf(test);
 			if (idx == NotFound) {
 				throw NotFoundException();
@@ -238,22 +301,28 @@ namespace foundation::types {
 			removeItemAtIndex(idx);
 		}
 
-		Strong<Array<T>> removingItem(const TesterIndex& test) const noexcept(false) {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t> || std::predicate<F&, T&>
+		Strong<Array<T>> removingItem(F&& test) const noexcept(false) {
 			Strong<Array<T>> result(*this);
 			result->removeItem(test);
 			return result;
 		}
 
+		inline void removeItem(const TesterIndex& test) noexcept(false) {
+			this->removeItem<const TesterIndex&>(test);
+		}
+
+		inline Strong<Array<T>> removingItem(const TesterIndex& test) const noexcept(false) {
+			return this->removingItem<const TesterIndex&>(test);
+		}
+
 		inline void removeItem(const Tester& test) noexcept(false) {
-			return removeItem([&test](T& item, const size_t) {
-				return test(item);
-			});
+			this->removeItem<const Tester&>(test);
 		}
 
-		Strong<Array<T>> removingItem(const Tester& test) const noexcept(false) {
-			Strong<Array<T>> result(*this);
-			result->removeItem(test);
-			return result;
+		inline Strong<Array<T>> removingItem(const Tester& test) const noexcept(false) {
+			return this->removingItem<const Tester&>(test);
 		}
 
 		inline void removeItem(const T& item1) noexcept(false) {
@@ -277,8 +346,14 @@ namespace foundation::types {
 
 		void replace(const T& item, const size_t& index) noexcept(false) {
 			Strong<T> reference = item;
-			reference->retain();
-			_storage.replace(reference, index)->release();
+			T* replaced;
+			{
+				CycleCollector::Lock::Guard guard(_lock);
+				if (index >= _storage.length()) throw OutOfBoundException(index);
+				replaced = _storage.replace(reference, index);
+			}
+			_retain(reference);
+			replaced->release();
 		}
 
 		Strong<Array<T>> replacing(const T& item, const size_t& idx) const noexcept(false) {
@@ -294,17 +369,30 @@ namespace foundation::types {
 			return *this;
 		}
 
-		size_t indexOf(const TesterIndex& test) const {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		size_t indexOf(F&& test) const {
 			for (size_t idx = 0 ; idx < _storage.length() ; idx++) {
 				if (test(*_storage[idx], idx)) return idx;
 			}
 			return NotFound;
 		}
 
+		template<typename F>
+		requires std::predicate<F&, T&>
+		size_t indexOf(F&& test) const {
+			for (size_t idx = 0 ; idx < _storage.length() ; idx++) {
+				if (test(*_storage[idx])) return idx;
+			}
+			return NotFound;
+		}
+
+		inline size_t indexOf(const TesterIndex& test) const {
+			return this->indexOf<const TesterIndex&>(test);
+		}
+
 		inline size_t indexOf(const Tester& test) const {
-			return indexOf([&test](T& item, const size_t) {
-				return test(item);
-			});
+			return this->indexOf<const Tester&>(test);
 		}
 
 		inline size_t indexOf(const T& item) const {
@@ -313,6 +401,12 @@ namespace foundation::types {
 			});
 		}
 
+		template<typename F>
+		requires std::predicate<F&, T&, size_t> || std::predicate<F&, T&>
+		inline bool contains(F&& test) const {
+			return indexOf(test) != NotFound;
+		}
+
 		inline bool contains(const TesterIndex& test) const {
 			return indexOf(test) != NotFound;
 		}
@@ -334,12 +428,18 @@ namespace foundation::types {
 			return this->first();
 		}
 
-		inline Strong<T> first(Tester tester) const noexcept(false) {
+		template<typename F>
+		requires std::predicate<F&, T&>
+		Strong<T> first(F&& tester) const noexcept(false) {
 			return _storage.first([&tester](T* item) {
 				return tester(*item);
 			});
 		}
 
+		inline Strong<T> first(Tester tester) const noexcept(false) {
+			return this->first<Tester&>(tester);
+		}
+
 		inline Strong<T> last() const noexcept(false) {
 			return _storage.last();
 		}
@@ -349,122 +449,230 @@ namespace foundation::types {
 			return NotFound;
 		}
 
+		template<typename F>
+		requires std::predicate<F&, T&>
+		size_t firstIndex(F&& tester) const {
+			return this->indexOf(tester);
+		}
+
 		inline size_t firstIndex(Tester tester) const {
-			for (size_t idx = 0 ; idx < count() ; idx++) {
-				if (tester(itemAtIndex(idx))) return idx;
-			}
-			return NotFound;
+			return this->firstIndex<Tester&>(tester);
 		}
 
 		inline size_t lastIndex() const {
 			return _storage.lastIndex();
 		}
 
-		inline size_t lastIndex(Tester tester) const {
+		template<typename F>
+		requires std::predicate<F&, T&>
+		size_t lastIndex(F&& tester) const {
 			return _storage.lastIndex([&tester](T* item) {
 				return tester(*item);
 			});
 		}
 
-		inline void forEach(const function<void(T& value)>& todo) const {
-			this->forEach([&todo](T& value, size_t) {
-				todo(value);
-			});
+		inline size_t lastIndex(Tester tester) const {
+			return this->lastIndex<Tester&>(tester);
 		}
 
-		inline void forEach(const function<void(T& value, size_t idx)>& todo) const {
+		// The algorithms below accept any callable, which the compiler can
+		// inline. The `function` overloads are kept for existing callers.
+
+		template<typename F>
+		requires std::invocable<F&, T&, size_t>
+		void forEach(F&& todo) const {
 			this->_storage.forEach([&todo](T* item, size_t idx) {
 				todo(*item, idx);
 			});
 		}
 
-		template<typename R>
-		inline R reduce(R initial, ReducerIndexStop<R> todo) const {
+		template<typename F>
+		requires std::invocable<F&, T&>
+		void forEach(F&& todo) const {
+			this->_storage.forEach([&todo](T* item) {
+				todo(*item);
+			});
+		}
+
+		inline void forEach(const function<void(T& value)>& todo) const {
+			this->forEach<const function<void(T& value)>&>(todo);
+		}
+
+		inline void forEach(const function<void(T& value, size_t idx)>& todo) const {
+			this->forEach<const function<void(T& value, size_t idx)>&>(todo);
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, R, T&, size_t, bool*>
+		R reduce(R initial, F&& todo) const {
 			return this->_storage.template reduce<R>(initial, [&todo](R result, T* item, size_t idx, bool* stop) {
 				return todo(result, *item, idx, stop);
 			});
 		}
 
+		template<typename R, typename F>
+		requires std::invocable<F&, R, T&, size_t>
+		R reduce(R initial, F&& todo) const {
+			return this->_storage.template reduce<R>(initial, [&todo](R result, T* item, size_t idx) {
+				return todo(result, *item, idx);
+			});
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, R, T&>
+		R reduce(R initial, F&& todo) const {
+			return this->_storage.template reduce<R>(initial, [&todo](R result, T* item) {
+				return todo(result, *item);
+			});
+		}
+
+		template<typename R>
+		inline R reduce(R initial, ReducerIndexStop<R> todo) const {
+			return this->reduce<R, ReducerIndexStop<R>&>(initial, todo);
+		}
+
 		template<typename R>
 		inline R reduce(R initial, ReducerIndex<R> todo) const {
-			return reduce<R>(initial, [&todo](R result, T& item, size_t idx, bool*) {
-				return todo(result, item, idx);
-			});
+			return this->reduce<R, ReducerIndex<R>&>(initial, todo);
 		}
 
 		template<typename R>
 		inline R reduce(R initial, Reducer<R> todo) const {
-			return reduce<R>(initial, [&todo](R result, T& item, size_t) {
-				return todo(result, item);
+			return this->reduce<R, Reducer<R>&>(initial, todo);
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, T&, size_t>
+		Strong<Array<R>> map(F&& transform) const {
+			Strong<Array<R>> result;
+			this->forEach([&transform,&result](T& item, size_t idx) {
+				result->append(transform(item, idx));
 			});
+			return std::move(result).autoreleased();
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, T&>
+		Strong<Array<R>> map(F&& transform) const {
+			Strong<Array<R>> result;
+			this->forEach([&transform,&result](T& item) {
+				result->append(transform(item));
+			});
+			return std::move(result).autoreleased();
 		}
 
 		template<typename R>
 		inline Strong<Array<R>> map(const function<Strong<R>(T&, size_t)>& transform) const {
-			return reduce<Strong<Array<R>>>(Strong<Array<R>>(), [&transform](Strong<Array<R>> result, T& item, const size_t& idx) {
-				return result->appending(transform(item, idx));
-			});
+			return this->map<R, const function<Strong<R>(T&, size_t)>&>(transform);
 		}
 
 		template<typename R>
 		inline Strong<Array<R>> map(const function<Strong<R>(T&)>& transform) const {
-			return map<R>([&transform](T& item, size_t) {
-				return transform(item);
+			return this->map<R, const function<Strong<R>(T&)>&>(transform);
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, T&, size_t>
+		Strong<Data<R>> mapToData(F&& transform) const {
+			Strong<Data<R>> result;
+			this->forEach([&transform,&result](T& item, size_t idx) {
+				result->append(transform(item, idx));
 			});
+			return result;
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, T&>
+		Strong<Data<R>> mapToData(F&& transform) const {
+			Strong<Data<R>> result;
+			this->forEach([&transform,&result](T& item) {
+				result->append(transform(item));
+			});
+			return result;
 		}
 
 		template<typename R>
 		inline Strong<Data<R>> mapToData(const function<R(T&, size_t)>& transform) const {
-			return reduce<Strong<Data<R>>>(
-				Strong<Data<R>>(),
-				[&transform](Strong<Data<R>> result, T& item, size_t idx) {
-					return result->appending(transform(item, idx));
-				});
+			return this->mapToData<R, const function<R(T&, size_t)>&>(transform);
 		}
 
 		template<typename R>
 		inline Strong<Data<R>> mapToData(const function<R(T&)>& transform) const {
-			return mapToData<R>([&transform](T& item, size_t) {
-				return transform(item);
-			});
+			return this->mapToData<R, const function<R(T&)>&>(transform);
 		}
 
-		inline Strong<Array<T>> filter(const TesterIndex& test) const {
-			return Strong<Array<T>>(this->_storage.filter([&test](T* item, const size_t& idx) {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		Strong<Array<T>> filter(F&& test) const {
+			return Strong<Array<T>>(this->_storage.filter([&test](T* item, size_t idx) {
 				return test(*item, idx);
-			}));
+			})).autoreleased();
+		}
+
+		template<typename F>
+		requires std::predicate<F&, T&>
+		Strong<Array<T>> filter(F&& test) const {
+			return Strong<Array<T>>(this->_storage.filter([&test](T* item) {
+				return test(*item);
+			})).autoreleased();
+		}
+
+		inline Strong<Array<T>> filter(const TesterIndex& test) const {
+			return this->filter<const TesterIndex&>(test);
 		}
 
 		inline Strong<Array<T>> filter(const Tester& test) const {
-			return filter([&test](T& item, const size_t&) {
-				return test(item);
-			});
+			return this->filter<const Tester&>(test);
 		}
 
-		inline bool some(const TesterIndex& test, bool def = false) const {
-			return this->_storage.some([&test](T* item, const size_t& idx) {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		bool some(F&& test, bool def = false) const {
+			return this->_storage.some([&test](T* item, size_t idx) {
 				return test(*item, idx);
 			}, def);
 		}
 
-		inline bool some(const Tester& test, bool def = false) const {
-			return some([&test](T& item, const size_t&) {
-				return test(item);
+		template<typename F>
+		requires std::predicate<F&, T&>
+		bool some(F&& test, bool def = false) const {
+			return this->_storage.some([&test](T* item) {
+				return test(*item);
 			}, def);
 		}
 
-		inline bool every(const TesterIndex& test, bool def = true) const {
-			return this->_storage.every([&test](T* item, const size_t& idx) {
+		inline bool some(const TesterIndex& test, bool def = false) const {
+			return this->some<const TesterIndex&>(test, def);
+		}
+
+		inline bool some(const Tester& test, bool def = false) const {
+			return this->some<const Tester&>(test, def);
+		}
+
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		bool every(F&& test, bool def = true) const {
+			return this->_storage.every([&test](T* item, size_t idx) {
 				return test(*item, idx);
 			}, def);
 		}
 
-		inline bool every(const Tester& test, bool def = true) const {
-			return every([&test](T& item, const size_t&) {
-				return test(item);
+		template<typename F>
+		requires std::predicate<F&, T&>
+		bool every(F&& test, bool def = true) const {
+			return this->_storage.every([&test](T* item) {
+				return test(*item);
 			}, def);
 		}
 
+		inline bool every(const TesterIndex& test, bool def = true) const {
+			return this->every<const TesterIndex&>(test, def);
+		}
+
+		inline bool every(const Tester& test, bool def = true) const {
+			return this->every<const Tester&>(test, def);
+		}
+
 		inline Strong<Array<T>> subarray(const size_t& index, const size_t& length) const {
 			return Strong<Array<T>>(this->_storage.subdata(index, length));
 		}
@@ -481,7 +689,9 @@ namespace foundation::types {
 			return Strong<Array<T>>(this->_storage.reversed());
 		}
 
-		Strong<Array<T>> unique(const Comparer& comparer) const {
+		template<typename F>
+		requires std::predicate<F&, T&, T&>
+		Strong<Array<T>> unique(F&& comparer) const {
 			Strong<Array<T>> result;
 			this->forEach([&result,&comparer](T& item1) {
 				if (!result->contains([&item1,&comparer](T& item2) { return comparer(item1, item2); })) {
@@ -491,23 +701,34 @@ namespace foundation::types {
 			return result;
 		}
 
+		inline Strong<Array<T>> unique(const Comparer& comparer) const {
+			return this->unique<const Comparer&>(comparer);
+		}
+
 		inline Strong<Array<T>> unique() const {
 			return this->unique([](const T& item1, const T& item2) { return item1.equals(item2); });
 		}
 
-		inline Strong<Array<T>> nonUnique(const Comparer& comparer) const {
+		template<typename F>
+		requires std::predicate<F&, T&, T&>
+		Strong<Array<T>> nonUnique(F&& comparer) const {
 			return this->filter([this,&comparer](T& item1) {
-				return this->filter([&comparer,&item1](T& item2) {
+				return this->count([&comparer,&item1](T& item2) {
 					return comparer(item1, item2);
-				})->count() > 1;
+				}) > 1;
 			});
 		}
 
+		inline Strong<Array<T>> nonUnique(const Comparer& comparer) const {
+			return this->nonUnique<const Comparer&>(comparer);
+		}
+
 		inline Strong<Array<T>> nonUnique() const {
-			return nonUnique([](const T& item1, const T& item2) { return item1 == item2; });
+			return nonUnique([](const T& item1, const T& item2) { return item1.equals(item2); });
 		}
 
 		void randomize() {
+			CycleCollector::Lock::Guard guard(_lock);
 			srand((uint32_t)time(NULL));
 			Data<T*> result;
 			while (_storage.count() > 0) {
@@ -519,36 +740,51 @@ namespace foundation::types {
 		}
 
 		inline void moveItemAtIndex(const size_t& srcIndex, const size_t& dstIndex) noexcept(false) {
+			CycleCollector::Lock::Guard guard(_lock);
 			this->_storage.moveItemAtIndex(srcIndex, dstIndex);
 		}
 
 		inline void swapItemAtIndices(const size_t& index1, const size_t& index2) noexcept(false) {
+			CycleCollector::Lock::Guard guard(_lock);
 			this->_storage.swapItemsAtIndices(index1, index2);
 		}
 
 		void insertItemAtIndex(Strong<T> item, const size_t& dstIndex) noexcept(false) {
 			if (dstIndex > this->count()) throw OutOfBoundException(dstIndex);
-			item->retain();
+			_retain(item);
+			CycleCollector::Lock::Guard guard(_lock);
 			_storage.insertItemAtIndex(item, dstIndex);
 		}
 
-		void sort(const Comparer comparer) {
+		template<typename F>
+		requires std::predicate<F&, T&, T&>
+		void sort(F&& comparer) {
 			if (this->count() <= 10) _insertionSort(*this, comparer);
 			else _quickSort(*this, 0, this->count(), comparer);
 		}
 
+		inline void sort(const Comparer comparer) {
+			this->sort<const Comparer&>(comparer);
+		}
+
 		inline void sort() {
-			this->sort([](const T& item1, const T& item2) { return item1 > item2; });
+			this->sort([](const T& item1, const T& item2) { return item1.greaterThan(item2); });
 		}
 
-		Strong<Array<T>> sorted(Comparer comparer) const {
+		template<typename F>
+		requires std::predicate<F&, T&, T&>
+		Strong<Array<T>> sorted(F&& comparer) const {
 			Strong<Array<T>> result = *this;
 			result->sort(comparer);
 			return result;
 		}
 
-		Strong<Array<T>> sorted() {
-			return this->sorted([](const T& item1, const T& item2) { return item1 > item2; });
+		inline Strong<Array<T>> sorted(Comparer comparer) const {
+			return this->sorted<Comparer&>(comparer);
+		}
+
+		Strong<Array<T>> sorted() const {
+			return this->sorted([](const T& item1, const T& item2) { return item1.greaterThan(item2); });
 		}
 
 		Strong<Array<Array<T>>> grouped(function<bool(const T&, const T&)> tester) const {
@@ -574,8 +810,16 @@ namespace foundation::types {
 			});
 		}
 
-		inline virtual uint64_t hash() const override {
-			return 0;
+		virtual uint64_t hash() const override {
+			if constexpr (std::is_base_of<Hashable, T>::value) {
+				Builder builder;
+				this->forEach([&builder](const T& item) {
+					builder.add(item);
+				});
+				return builder;
+			} else {
+				return 0;
+			}
 		}
 
 		inline virtual Kind kind() const override {
@@ -615,24 +859,43 @@ namespace foundation::types {
 
 		}
 
+		virtual bool isCollectable() const override {
+			return true;
+		}
+
+		virtual size_t retainedCount() const override {
+			CycleCollector::Lock::Guard guard(_lock);
+			return _storage.length();
+		}
+
+		virtual const Object* lockRetainedAt(size_t index) const override {
+			CycleCollector::Lock::Guard guard(_lock);
+			if (index >= _storage.length()) return nullptr;
+			_storage[index]->retain();
+			return _storage[index];
+		}
+
+		virtual void releaseRetained() override {
+			*this = Array<T>();
+		}
+
 		Array<T>& operator=(const Array<T>& other) {
 			Type::operator=(other);
-			for (size_t idx = 0 ; idx < _storage.length() ; idx++) {
-				_storage[idx]->release();
-			}
-			_storage.drain();
-			for (size_t idx = 0 ; idx < other._storage.length() ; idx++) {
-				other._storage[idx]->retain();
-				_storage.append(other._storage[idx]);
+			Storage storage(other._storage);
+			for (size_t idx = 0 ; idx < storage.length() ; idx++) {
+				_retain(storage[idx]);
 			}
+			_exchange(storage);
 			return *this;
 		}
 
 		Array<T>& operator=(Array<T>&& other) {
-			for (size_t idx = 0 ; idx < this->_storage.length() ; idx++) {
-				this->_storage[idx]->release();
+			Storage storage;
+			{
+				CycleCollector::Lock::Guard guard(other._lock);
+				storage = std::move(other._storage);
 			}
-			_storage = std::move(other._storage);
+			_exchange(storage);
 			Type::operator=(std::move(other));
 			return *this;
 		}
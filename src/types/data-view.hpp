@@ -0,0 +1,131 @@
+//
+// data-view.hpp
+// foundation
+//
+// Created by Kristian Trenskow on 2026/10/17.
+// See license in LICENSE.
+//
+
+#ifndef foundation_data_view_hpp
+#define foundation_data_view_hpp
+
+#include <stddef.h>
+#include <string.h>
+
+#include <span>
+#include <type_traits>
+
+#include "../exceptions/exception.hpp"
+#include "../tools/math.hpp"
+#include "../tools/search.hpp"
+
+using namespace foundation::exceptions::types;
+using namespace foundation::tools;
+
+namespace foundation::types {
+
+	template<typename T>
+	class Data;
+
+	// A non-owning, read-only window into contiguous items. Views do not retain
+	// anything, so they must not outlive – or be used across mutations of – the
+	// data they were taken from. Indexing with `[]` is unchecked.
+	template<typename T = uint8_t>
+	class DataView {
+
+	public:
+
+		using value_type = T;
+		using size_type = size_t;
+		using iterator = const T*;
+		using const_iterator = const T*;
+
+		static const size_t NotFound = math::limit<size_t>();
+
+		constexpr DataView() : _items(nullptr), _length(0) { }
+
+		constexpr DataView(const T* items, size_t length) : _items(items), _length(length) { }
+
+		constexpr DataView(std::span<const T> span) : _items(span.data()), _length(span.size()) { }
+
+		DataView(const Data<T>& data) : _items(data.items()), _length(data.length()) { }
+
+		constexpr const T* items() const {
+			return this->_items;
+		}
+
+		constexpr size_t length() const {
+			return this->_length;
+		}
+
+		constexpr bool isEmpty() const {
+			return this->_length == 0;
+		}
+
+		constexpr const T& operator[](size_t index) const {
+			return this->_items[index];
+		}
+
+		T itemAtIndex(size_t index) const noexcept(false) {
+			if (index >= this->_length) throw OutOfBoundException(index);
+			return this->_items[index];
+		}
+
+		constexpr const T* begin() const {
+			return this->_items;
+		}
+
+		constexpr const T* end() const {
+			return this->_items + this->_length;
+		}
+
+		constexpr DataView<T> subview(size_t offset, size_t length = NotFound) const {
+			offset = math::min(offset, this->_length);
+			return DataView<T>(this->_items + offset, math::min(length, this->_length - offset));
+		}
+
+		size_t indexOf(const DataView<T>& other, size_t offset = 0) const {
+			if (offset >= this->_length) return NotFound;
+			if (other._length == 0) return offset;
+			size_t result = search::find(this->_items + offset, this->_length - offset, other._items, other._length);
+			if (result == NotFound) return NotFound;
+			return offset + result;
+		}
+
+		inline size_t indexOf(T other, size_t offset = 0) const {
+			return this->indexOf(DataView<T>(&other, 1), offset);
+		}
+
+		bool equals(const DataView<T>& other) const {
+			if (this->_length != other._length) return false;
+			if constexpr (std::has_unique_object_representations<T>::value) {
+				return this->_length == 0 || memcmp(this->_items, other._items, sizeof(T) * this->_length) == 0;
+			}
+			for (size_t idx = 0 ; idx < this->_length ; idx++) {
+				if (this->_items[idx] != other._items[idx]) return false;
+			}
+			return true;
+		}
+
+		inline bool hasPrefix(const DataView<T>& other) const {
+			return other._length <= this->_length && this->subview(0, other._length).equals(other);
+		}
+
+		inline bool hasSuffix(const DataView<T>& other) const {
+			return other._length <= this->_length && this->subview(this->_length - other._length).equals(other);
+		}
+
+		constexpr operator std::span<const T>() const {
+			return std::span<const T>(this->_items, this->_length);
+		}
+
+	private:
+
+		const T* _items;
+		size_t _length;
+
+	};
+
+}
+
+#endif /* foundation_data_view_hpp */
@@ -13,15 +13,44 @@
 #include <string.h>
 #include <stdarg.h>
 
+#include <concepts>
+#include <type_traits>
+
 #include "../memory/strong.hpp"
+#include "../memory/statistics.hpp"
 #include "../exceptions/exception.hpp"
+#include "../parallelism/parallel.hpp"
+#include "../tools/base64.hpp"
+#include "../tools/checksum.hpp"
+#include "../tools/hex.hpp"
+#include "../tools/lz4.hpp"
+#include "../tools/search.hpp"
+#include "../tools/multi-search.hpp"
 #include "./type.hpp"
+#include "./data-view.hpp"
 #include "./array.hpp"
 
 #define MAX(x, y) (x > y ? x : y)
 
+#ifndef FOUNDATION_DATA_INLINE_SIZE
+#define FOUNDATION_DATA_INLINE_SIZE 64
+#endif
+
+#ifndef FOUNDATION_DATA_CHUNK_SIZE
+#define FOUNDATION_DATA_CHUNK_SIZE 4096
+#endif
+
+#ifndef FOUNDATION_DATA_COMPACTION_RATIO
+#define FOUNDATION_DATA_COMPACTION_RATIO 8
+#endif
+
+#ifndef FOUNDATION_DATA_COMPACTION_THRESHOLD
+#define FOUNDATION_DATA_COMPACTION_THRESHOLD 65536
+#endif
+
 using namespace foundation::memory;
 using namespace foundation::exceptions::types;
+using namespace foundation::parallelism;
 using namespace foundation::tools;
 
 namespace foundation::types {
@@ -38,6 +67,9 @@ namespace foundation::types {
 	template<typename T>
 	class Array;
 
+	template<typename T>
+	class DataBuilder;
+
 	template<typename T = uint8_t>
 	class Data : public Type, public Comparable<Data<T>> {
 
@@ -58,17 +90,31 @@ namespace foundation::types {
 		using ReducerIndexStop = function<R(R result, T item, size_t idx, bool* stop)>;
 
 		static Data<T> fromCBuffer(const function<size_t(T*,size_t)>& todo, size_t length) {
-			T buffer[length];
-			size_t read = todo(buffer, length);
-			return Data<T>((T*)buffer, math::min(read, length));
+			DataBuilder<T> builder(length);
+			builder.commit(math::min(todo(builder.reserve(length), length), length));
+			return builder.build();
+		}
+
+		// Maps the first `size` bytes of the file behind `descriptor` read-only.
+		// The mapping is shared between copies, and is only copied into private
+		// storage when mutated. Throws `AllocationException` if the file cannot
+		// be mapped.
+		static Data<T> fromMappedFile(int descriptor, size_t size) noexcept(false) {
+			Data<T> result;
+			if (size < sizeof(T)) return result;
+			result._storage = Storage::map(descriptor, size);
+			result._length = result._storage->capacity();
+			return result;
 		}
 
-		Data(const T* items, size_t length) : Type(), _storage(new Storage()), _offset(0), _length(0), _size(sizeof(T)), _hashIsDirty(true), _hash(0) {
+		Data(const T* items, size_t length) : Type(), _storage(nullptr), _offset(0), _length(0), _size(sizeof(T)), _growth(Growth::twice), _hashIsDirty(true), _hash(0), _chunks(nullptr) {
 			append(items, length);
 		}
 
 		Data() : Data(nullptr, 0) {}
 
+		Data(const DataView<T>& view) : Data(view.items(), view.length()) {}
+
 		Data(size_t capacity) : Data() {
 			this->_ensureStorageSize(capacity);
 		}
@@ -85,7 +131,9 @@ namespace foundation::types {
 			}
 		}
 
-		Data(const Data<T>& other, size_t offset, size_t length) : _storage(other._storage->retain()), _offset(other._offset + offset), _length(length), _size(sizeof(T)), _hashIsDirty(offset == 0 && length == other._length), _hash(other._hash) { }
+		Data(const Data<T>& other, size_t offset, size_t length) : _storage(nullptr), _offset(0), _length(length), _size(sizeof(T)), _growth(other._growth), _hashIsDirty(other._hashIsDirty || offset != 0 || length != other._length), _hash(other._hash), _chunks(nullptr) {
+			this->_share(other, offset, length);
+		}
 
 		Data(const Data<T>& other) : Data(other, 0, other._length) { }
 
@@ -93,7 +141,10 @@ namespace foundation::types {
 			this->_storage = other._storage;
 			this->_offset = other._offset;
 			this->_length = other._length;
+			this->_chunks = other._chunks;
+			if (this->_storage == nullptr) this->_takeInline(other, 0, this->_headLength());
 			this->_size = other._size;
+			this->_growth = other._growth;
 			this->_hashIsDirty = other._hashIsDirty;
 			this->_hash = other._hash;
 			other._storage = nullptr;
@@ -101,9 +152,11 @@ namespace foundation::types {
 			other._length = 0;
 			other._size = 0;
 			other._hashIsDirty = true;
+			other._chunks = nullptr;
 		}
 
 		virtual ~Data() {
+			delete this->_chunks;
 			Storage::release(&this->_storage);
 			this->_offset = 0;
 			this->_length = 0;
@@ -112,6 +165,7 @@ namespace foundation::types {
 
 		void append(const T* items, size_t length) {
 			if (!length) return;
+			if (this->_chunks != nullptr) return this->_appendChunk(items, length);
 			this->insertItemsAtIndex(items, length, this->length());
 		}
 
@@ -120,6 +174,7 @@ namespace foundation::types {
 		}
 
 		inline void append(const Data<T>& data) {
+			if (this->_chunks != nullptr) return this->_appendChunk(data);
 			append(data.items(), data.length());
 		}
 
@@ -143,8 +198,15 @@ namespace foundation::types {
 
 			T element = this->_get(index);
 
-			for (size_t idx = index ; idx < this->length() - 1 ; idx++) {
-				this->_set(idx, this->_get(idx + 1));
+			if (index == 0) {
+				this->_offset++;
+			} else if constexpr (_isTriviallyCopyable) {
+				T* items = this->_items();
+				memmove(items + index, items + index + 1, sizeof(T) * (this->length() - index - 1));
+			} else {
+				for (size_t idx = index ; idx < this->length() - 1 ; idx++) {
+					this->_set(idx, this->_get(idx + 1));
+				}
 			}
 
 			this->_length--;
@@ -169,7 +231,14 @@ namespace foundation::types {
 
 			T src = this->_get(srcIndex);
 
-			if (srcIndex < dstIndex) {
+			if constexpr (_isTriviallyCopyable) {
+				T* items = this->_items();
+				if (srcIndex < dstIndex) {
+					memmove(items + srcIndex, items + srcIndex + 1, sizeof(T) * (dstIndex - srcIndex));
+				} else {
+					memmove(items + dstIndex + 1, items + dstIndex, sizeof(T) * (srcIndex - dstIndex));
+				}
+			} else if (srcIndex < dstIndex) {
 				for (size_t idx = srcIndex + 1 ; idx <= dstIndex ; idx++) {
 					this->_set(idx - 1, this->_get(idx));
 				}
@@ -180,6 +249,7 @@ namespace foundation::types {
 			}
 
 			this->_set(dstIndex, src);
+			this->_hashIsDirty = true;
 
 		}
 
@@ -195,6 +265,7 @@ namespace foundation::types {
 			T reg = this->_get(index1);
 			this->_set(index1, this->_get(index2));
 			this->_set(index2, reg);
+			this->_hashIsDirty = true;
 
 		}
 
@@ -204,15 +275,24 @@ namespace foundation::types {
 
 			this->_ensureStorageSize(this->length() + length);
 
-			for (size_t idx = this->length() ; idx > dstIndex ; idx--) {
-				this->_set(idx + length - 1, this->_get(idx - 1));
-			}
+			if constexpr (_isTriviallyCopyable) {
+				T* destination = this->_items();
+				memmove(destination + dstIndex + length, destination + dstIndex, sizeof(T) * (this->length() - dstIndex));
+				memcpy(destination + dstIndex, items, sizeof(T) * length);
+			} else {
+
+				for (size_t idx = this->length() ; idx > dstIndex ; idx--) {
+					this->_set(idx + length - 1, this->_get(idx - 1));
+				}
+
+				for (size_t idx = 0 ; idx < length ; idx++) {
+					this->_set(idx + dstIndex, items[idx]);
+				}
 
-			for (size_t idx = 0 ; idx < length ; idx++) {
-				this->_set(idx + dstIndex, items[idx]);
 			}
 
 			this->_length += length;
+			this->_hashIsDirty = true;
 
 		}
 
@@ -221,7 +301,7 @@ namespace foundation::types {
 		}
 
 		inline const T* items() const {
-			return *_storage + _offset;
+			return this->_items();
 		}
 
 		inline size_t length() const {
@@ -232,14 +312,112 @@ namespace foundation::types {
 			return this->_size;
 		}
 
-		size_t count(function<bool(T& item)> tester) const {
+		inline size_t capacity() const {
+			return this->_capacity() - this->_offset;
+		}
+
+		void reserve(size_t capacity) {
+			this->_ensureStorageSize(capacity, Growth::exact);
+		}
+
+		void shrinkToFit() {
+			this->_flatten();
+			if (this->_storage != nullptr) {
+				this->_ensureStorageOwnership();
+				if (this->_length <= _inlineCapacity) {
+					Storage* storage = this->_storage;
+					this->_storage = nullptr;
+					this->_copyItems((T*)this->_inline, (const T*)*storage + this->_offset, this->_length);
+					this->_offset = 0;
+					Storage::release(&storage);
+					return;
+				}
+			}
+			if (this->_offset > 0) this->_compact();
+			if (this->_storage != nullptr) this->_storage->resize(this->_length);
+		}
+
+		// Copies and slices share storage with the data they were taken from.
+		// Slices that fit inline are copied, and so are slices that would use less
+		// than 1/`FOUNDATION_DATA_COMPACTION_RATIO` of a storage of at least
+		// `FOUNDATION_DATA_COMPACTION_THRESHOLD` bytes, so that a small slice does
+		// not keep a large buffer alive.
+
+		// The bytes of heap or mapped storage this data keeps alive. The storage
+		// may be shared with other instances.
+		size_t retainedBytes() const {
+			size_t result = this->_storage != nullptr ? sizeof(T) * this->_storage->capacity() : 0;
+			if (this->_chunks != nullptr) {
+				for (Chunk* chunk = this->_chunks->first ; chunk != nullptr ; chunk = chunk->next) {
+					result += chunk->data.retainedBytes();
+				}
+			}
+			return result;
+		}
+
+		inline size_t usedBytes() const {
+			return sizeof(T) * this->length();
+		}
+
+		// Lets go of retained storage that is not used, copying the items if the
+		// storage is shared.
+		void compact() {
+			if (this->retainedBytes() > this->usedBytes()) this->shrinkToFit();
+		}
+
+		inline Growth growth() const {
+			return this->_growth;
+		}
+
+		inline void setGrowth(Growth growth) {
+			this->_growth = growth;
+		}
+
+		// In chunked mode appends are collected in a list of chunks instead of
+		// being copied into one buffer. Appended data is shared rather than
+		// copied, and smaller appends are gathered in chunks of
+		// `FOUNDATION_DATA_CHUNK_SIZE` bytes. The chunks are joined the first
+		// time the items are accessed, so a chunked instance must not be read
+		// from several threads at once. Copies are never chunked.
+		inline bool isChunked() const {
+			return this->_chunks != nullptr;
+		}
+
+		void setChunked(bool chunked) {
+			if (chunked == this->isChunked()) return;
+			if (chunked) {
+				this->_chunks = new Chunks();
+			} else {
+				this->_flatten();
+				delete this->_chunks;
+				this->_chunks = nullptr;
+			}
+		}
+
+		// Calls `todo` with every contiguous run of items in order, without
+		// joining the chunks of chunked data.
+		void forEachChunk(const function<void(const T* items, size_t length)>& todo) const {
+			if (this->_headLength() > 0) todo(this->_buffer() + this->_offset, this->_headLength());
+			if (this->_chunks == nullptr) return;
+			for (Chunk* chunk = this->_chunks->first ; chunk != nullptr ; chunk = chunk->next) {
+				todo(chunk->data.items(), chunk->data.length());
+			}
+		}
+
+		template<typename F>
+		requires std::predicate<F&, T&>
+		size_t count(F&& tester) const {
 			size_t result = 0;
-			this->forEach([&tester,&result](T& item) {
-				if (tester(item)) result++;
-			});
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				if (tester(this->_get(idx))) result++;
+			}
 			return result;
 		}
 
+		inline size_t count(function<bool(T& item)> tester) const {
+			return this->count<function<bool(T& item)>&>(tester);
+		}
+
 		size_t count(const T& item) const {
 			return this->count([&item](const T& other) {
 				return item == other;
@@ -262,7 +440,9 @@ namespace foundation::types {
 			return this->_get(0);
 		}
 
-		T first(Tester tester) const noexcept(false) {
+		template<typename F>
+		requires std::predicate<F&, T&>
+		T first(F&& tester) const noexcept(false) {
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				T current = this->_get(idx);
 				if (tester(current)) return current;
@@ -270,6 +450,10 @@ namespace foundation::types {
 			throw NotFoundException();
 		}
 
+		inline T first(Tester tester) const noexcept(false) {
+			return this->first<Tester&>(tester);
+		}
+
 		T last() const noexcept(false) {
 			if (this->length() == 0) {
 				throw NotFoundException();
@@ -282,17 +466,29 @@ namespace foundation::types {
 			return this->length() - 1;
 		}
 
+		template<typename F>
+		requires std::predicate<F&, T&>
+		size_t lastIndex(F&& tester) const {
+			for (size_t idx = this->length() ; idx > 0 ; idx--) {
+				if (tester(this->_get(idx - 1))) return idx - 1;
+			}
+			return NotFound;
+		}
+
 		inline size_t lastIndex(Tester tester) const {
-			return reduce<size_t>(NotFound, [&tester](size_t result, T& item, const size_t idx) {
-				if (tester(item)) return idx;
-				return result;
-			});
+			return this->lastIndex<Tester&>(tester);
 		}
 
 		bool needle(const Data<T>& other, size_t offset) const {
 
 			if (other.length() + offset > this->length()) return false;
 
+			if (other.length() == 0) return true;
+
+			if constexpr (_isBitwiseComparable) {
+				return memcmp(this->items() + offset, other.items(), sizeof(T) * other.length()) == 0;
+			}
+
 			for (size_t idx = 0 ; idx < other.length() ; idx++) {
 				if (this->_get(offset + idx) != other._get(idx)) {
 					return false;
@@ -304,21 +500,24 @@ namespace foundation::types {
 		}
 
 		size_t indexOf(const Data<T>& other, size_t offset = 0) const {
-			for (size_t index = offset ; index < this->length() ; index++) {
-				if (this->needle(other, index)) return index;
-			}
-			return NotFound;
+			if (offset >= this->length()) return NotFound;
+			if (other.length() == 0) return offset;
+			size_t result = search::find(this->items() + offset, this->length() - offset, other.items(), other.length());
+			if (result == NotFound) return NotFound;
+			return offset + result;
 		}
 
 		inline size_t indexOf(T other, size_t offset = 0) const {
-			return indexOf(Data<T>(&other, 1), offset);
+			if (offset >= this->length()) return NotFound;
+			size_t result = search::find(this->items() + offset, this->length() - offset, &other, 1);
+			if (result == NotFound) return NotFound;
+			return offset + result;
 		}
 
 		size_t lastIndexOf(const Data<T>& other) const {
-			for (ssize_t index = this->length() - other.length(); index >= 0 ; index--) {
-				if (this->needle(other, (size_t)index)) return index;
-			}
-			return NotFound;
+			if (other.length() > this->length()) return NotFound;
+			if (other.length() == 0) return this->length();
+			return search::findLast(this->items(), this->length(), other.items(), other.length());
 		}
 
 		inline bool contains(const Data<T>& other, size_t offset = 0) const {
@@ -330,21 +529,19 @@ namespace foundation::types {
 		}
 
 		bool hasPrefix(const Data<T>& other) const {
-			if (other.length() > this->length()) return false;
-			return this->subdata(0, other.length())
-				->equals(other);
+			return this->needle(other, 0);
 		}
 
 		bool hasSuffix(const Data<T>& other) const {
 			if (other.length() > this->length()) return false;
-			return this->subdata(this->length() - other.length(), other.length())
-				->equals(other);
+			return this->needle(other, this->length() - other.length());
 		}
 
 		T replace(T element, size_t index) {
 			this->_ensureStorageOwnership();
 			T removed = this->_get(index);
 			this->_set(index, element);
+			this->_hashIsDirty = true;
 			return removed;
 		}
 
@@ -356,6 +553,20 @@ namespace foundation::types {
 			return oldValue;
 		}
 
+		// Views do not retain the storage, so they are only valid until this
+		// data is mutated or released.
+		inline DataView<T> view(size_t offset = 0, size_t length = NotFound) const {
+			return DataView<T>(*this).subview(offset, length);
+		}
+
+		inline const T* begin() const {
+			return this->items();
+		}
+
+		inline const T* end() const {
+			return this->items() + this->length();
+		}
+
 		Strong<Data<T>> subdata(size_t offset, size_t length = NotFound) const {
 			if (length == NotFound) length = this->_length;
 			length = (size_t)math::min((ssize_t)this->length() - (ssize_t)offset, (ssize_t)length);
@@ -385,15 +596,32 @@ namespace foundation::types {
 
 			this->_ensureStorageOwnership();
 
-			Strong<Data<T>> result = this->subdata(offset, length);
+			// Removing from the front leaves the items in place, so the result
+			// can share them. Otherwise they are overwritten below, and must be
+			// copied first.
+			if (offset == 0) {
+				Strong<Data<T>> result = this->subdata(0, length);
+				this->_offset += length;
+				this->_length -= length;
+				this->_hashIsDirty = true;
+				return result;
+			}
+
+			Strong<Data<T>> result(this->_items() + offset, length);
 
 			size_t moveCount = this->length() - (offset + length);
 
-			for (size_t idx = 0 ; idx < moveCount ; idx++) {
-				this->_set(offset + idx, this->_get(offset + length + idx));
+			if constexpr (_isTriviallyCopyable) {
+				T* items = this->_items();
+				memmove(items + offset, items + offset + length, sizeof(T) * moveCount);
+			} else {
+				for (size_t idx = 0 ; idx < moveCount ; idx++) {
+					this->_set(offset + idx, this->_get(offset + length + idx));
+				}
 			}
 
 			this->_length -= length;
+			this->_hashIsDirty = true;
 
 			return result;
 
@@ -401,24 +629,31 @@ namespace foundation::types {
 
 		Strong<Data<T>> reversed() const {
 			Strong<Data<T>> result;
-			for (size_t idx = this->length() ; idx > 0 ; idx--) {
-				result->append(this->_get(idx - 1));
+			if (this->length() == 0) return result;
+			result->_ensureStorageSize(this->length(), Growth::exact);
+			T* items = result->_items();
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				items[idx] = this->_get(this->length() - idx - 1);
 			}
+			result->_length = this->length();
 			return result;
 		}
 
 		void drain() {
+			if (this->_chunks != nullptr) {
+				delete this->_chunks;
+				this->_chunks = new Chunks();
+			}
 			Storage::release(&this->_storage);
-			_storage = new Storage();
 			_length = 0;
 			_offset = 0;
+			_hashIsDirty = true;
 		};
 
 		size_t copy(void* bytes, size_t length, size_t offset = 0) {
 			if (offset > this->length()) return 0;
-			this->_ensureStorageOwnership();
 			length = math::min(length, this->length() - offset);
-			memcpy(bytes, this->items(), sizeof(T) * length);
+			memcpy(bytes, this->items() + offset, sizeof(T) * length);
 			return length;
 		}
 
@@ -428,58 +663,117 @@ namespace foundation::types {
 			});
 		}
 
+		// Separators are found in a single pass. Where more than one matches, the
+		// one starting first wins, and the longest of those starting at the same
+		// index. The parts share storage with this data.
 		Strong<Array<Data<T>>> split(const Array<Data<T>>& separators, IncludeSeparator includeSeparator = IncludeSeparator::none, size_t max = 0) const {
-			Strong<Array<Data<T>>> result;
-			size_t idx = 0;
-			while (result->count() < max - 1) {
-				if (!separators.some([this,&idx,&result,&includeSeparator](const Data<T>& separator) {
-					size_t next = NotFound;
-					switch (includeSeparator) {
-						case IncludeSeparator::none:
-						case IncludeSeparator::suffix:
-							next = indexOf(separator, idx);
-							break;
-						case IncludeSeparator::prefix:
-						case IncludeSeparator::both:
-							next = indexOf(separator, idx + separator.length());
-							break;
-					}
-					if (next == NotFound) return false;
-					switch (includeSeparator) {
-						case IncludeSeparator::none:
-						case IncludeSeparator::prefix:
-							result->append(subdata(idx, next - idx));
-							break;
-						case IncludeSeparator::suffix:
-						case IncludeSeparator::both:
-							result->append(subdata(idx, next - idx + separator.length()));
-							break;
-					}
-					switch (includeSeparator) {
-						case IncludeSeparator::none:
-						case IncludeSeparator::suffix:
-							idx = next + separator.length();
-							break;
-						case IncludeSeparator::prefix:
-						case IncludeSeparator::both:
-							idx = next;
-							break;
-					}
-					return true;
-				})) break;
-			}
-			result->append(subdata(idx, length() - idx));
-			return result;
+			MultiSearch<T> matcher(separators.count(), [&separators](size_t idx) {
+				return separators[idx]->view();
+			});
+			return this->_split(includeSeparator, max, [this,&matcher](size_t offset) {
+				return matcher.find(this->items(), this->length(), offset);
+			});
 		}
 
-		inline Strong<Array<Data<T>>> split(const Data<T>& separator, IncludeSeparator includeSeparator = IncludeSeparator::none, size_t max = 0) const {
-			return split(Array<Data<T>>(separator, 1), includeSeparator, max);
+		Strong<Array<Data<T>>> split(const Data<T>& separator, IncludeSeparator includeSeparator = IncludeSeparator::none, size_t max = 0) const {
+			return this->_split(includeSeparator, max, [this,&separator](size_t offset) {
+				return _Match { separator.length() > 0 ? this->indexOf(separator, offset) : NotFound, separator.length(), 0 };
+			});
 		}
 
 		inline Strong<Array<Data<T>>> split(T* separator, size_t length, IncludeSeparator includeSeparator = IncludeSeparator::none, size_t max = 0) const {
 			return split(Data<T>(separator, length), includeSeparator, max);
 		}
 
+		Strong<Data<T>> replacing(const Array<Data<T>>& needles, const Data<T>& replacement) const {
+			MultiSearch<T> matcher(needles.count(), [&needles](size_t idx) {
+				return needles[idx]->view();
+			});
+			return this->_replacing(replacement, [this,&matcher](size_t offset) {
+				return matcher.find(this->items(), this->length(), offset);
+			});
+		}
+
+		Strong<Data<T>> replacing(const Data<T>& needle, const Data<T>& replacement) const {
+			return this->_replacing(replacement, [this,&needle](size_t offset) {
+				return _Match { needle.length() > 0 ? this->indexOf(needle, offset) : NotFound, needle.length(), 0 };
+			});
+		}
+
+		// Compresses into an LZ4 frame, which can also be read by the `lz4` tool.
+		Strong<Data<T>> compressed(lz4::BlockSize blockSize = lz4::BlockSize::size256KB) const requires std::same_as<T, uint8_t> {
+			DataBuilder<T> builder;
+			lz4::Encoder encoder([&builder](const uint8_t* bytes, size_t length) {
+				builder.append(bytes, length);
+			}, blockSize);
+			this->forEachChunk([&encoder](const T* items, size_t length) {
+				encoder.write(items, length);
+			});
+			encoder.finish();
+			return Strong<Data<T>>(builder.build());
+		}
+
+		// Decompresses one or more LZ4 frames. Throws `MalformedCompressedDataException`
+		// if the data is not complete, valid frames.
+		Strong<Data<T>> decompressed() const noexcept(false) requires std::same_as<T, uint8_t> {
+			DataBuilder<T> builder;
+			lz4::Decoder decoder([&builder](const uint8_t* bytes, size_t length) {
+				builder.append(bytes, length);
+			});
+			this->forEachChunk([&decoder](const T* items, size_t length) {
+				decoder.write(items, length);
+			});
+			if (!decoder.isFinished()) throw exceptions::tools::MalformedCompressedDataException(this->length());
+			return Strong<Data<T>>(builder.build());
+		}
+
+		Strong<Data<T>> hexEncoded(bool uppercase = true) const requires std::same_as<T, uint8_t> {
+			DataBuilder<T> builder;
+			hex::encode(this->items(), this->length(), builder.reserve(this->length() * 2), uppercase);
+			builder.commit(this->length() * 2);
+			return Strong<Data<T>>(builder.build());
+		}
+
+		// Throws `DecoderException` on invalid characters or an odd length.
+		Strong<Data<T>> hexDecoded() const noexcept(false) requires std::same_as<T, uint8_t> {
+			DataBuilder<T> builder;
+			hex::decode(this->items(), this->length(), builder.reserve(this->length() / 2));
+			builder.commit(this->length() / 2);
+			return Strong<Data<T>>(builder.build());
+		}
+
+		Strong<Data<T>> base64Encoded(base64::Alphabet alphabet = base64::Alphabet::standard, bool padding = true) const requires std::same_as<T, uint8_t> {
+			DataBuilder<T> builder;
+			builder.commit(base64::encode(this->items(), this->length(), builder.reserve(base64::encodedLength(this->length(), padding)), alphabet, padding));
+			return Strong<Data<T>>(builder.build());
+		}
+
+		// Throws `DecoderException` on invalid characters, padding or trailing bits.
+		Strong<Data<T>> base64Decoded(base64::Alphabet alphabet = base64::Alphabet::standard) const noexcept(false) requires std::same_as<T, uint8_t> {
+			DataBuilder<T> builder;
+			builder.commit(base64::decode(this->items(), this->length(), builder.reserve(base64::maximumDecodedLength(this->length())), alphabet));
+			return Strong<Data<T>>(builder.build());
+		}
+
+		// Checksums stay the same across processes, unlike `hash`. Use
+		// `checksum::CRC32C` and `checksum::XXHash64` directly to checksum input
+		// that arrives in pieces, like reads from a file.
+		uint32_t crc32c() const requires std::same_as<T, uint8_t> {
+			checksum::CRC32C result;
+			this->forEachChunk([&result](const T* items, size_t length) {
+				result.update(items, length);
+			});
+			return result.value();
+		}
+
+		uint64_t xxhash64(uint64_t seed = 0) const requires std::same_as<T, uint8_t> {
+			checksum::XXHash64 result(seed);
+			this->forEachChunk([&result](const T* items, size_t length) {
+				result.update(items, length);
+			});
+			return result.value();
+		}
+
 		inline static Strong<Data<T>> join(const Array<Data<T>>& items, const Data<T>* separator) {
 			return items.template reduce<Strong<Data<T>>>(Strong<Data<T>>(), [items, separator](Strong<Data<T>> result, Data<T>&, size_t idx) {
 				result->append(items[idx]);
@@ -498,23 +792,39 @@ namespace foundation::types {
 
 		template<typename O>
 		inline Strong<Data<O>> as() const {
-			return Strong<Data<O>>((const O*)((T*)*this->_storage), (this->length() * sizeof(T)) / sizeof(O));
+			return Strong<Data<O>>((const O*)this->items(), (this->length() * sizeof(T)) / sizeof(O));
 		}
 
-		void forEach(function<void(T& item, size_t idx)> todo) const {
+		// The algorithms below accept any callable, which the compiler can
+		// inline. The `function` overloads are kept for existing callers.
+
+		template<typename F>
+		requires std::invocable<F&, T&, size_t>
+		void forEach(F&& todo) const {
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				todo(this->_get(idx), idx);
 			}
 		}
 
+		template<typename F>
+		requires std::invocable<F&, T&>
+		void forEach(F&& todo) const {
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				todo(this->_get(idx));
+			}
+		}
+
+		inline void forEach(function<void(T& item, size_t idx)> todo) const {
+			this->forEach<function<void(T& item, size_t idx)>&>(todo);
+		}
+
 		inline void forEach(function<void(T& item)> todo) const {
-			this->forEach([&todo](T& item, size_t) {
-				todo(item);
-			});
+			this->forEach<function<void(T& item)>&>(todo);
 		}
 
-		template<typename R>
-		R reduce(R initial, ReducerIndexStop<R> todo) const {
+		template<typename R, typename F>
+		requires std::invocable<F&, R, T&, size_t, bool*>
+		R reduce(R initial, F&& todo) const {
 			R result = initial;
 			bool stop = false;
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
@@ -524,21 +834,44 @@ namespace foundation::types {
 			return result;
 		}
 
+		template<typename R, typename F>
+		requires std::invocable<F&, R, T&, size_t>
+		R reduce(R initial, F&& todo) const {
+			R result = initial;
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				result = todo(result, this->_get(idx), idx);
+			}
+			return result;
+		}
+
+		template<typename R, typename F>
+		requires std::invocable<F&, R, T&>
+		R reduce(R initial, F&& todo) const {
+			R result = initial;
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				result = todo(result, this->_get(idx));
+			}
+			return result;
+		}
+
 		template<typename R>
-		R reduce(R initial, ReducerIndex<R> todo) const {
-			return reduce<R>(initial, [&todo](R result, T item, size_t idx, bool*) {
-				return todo(result, item, idx);
-			});
+		inline R reduce(R initial, ReducerIndexStop<R> todo) const {
+			return this->reduce<R, ReducerIndexStop<R>&>(initial, todo);
+		}
+
+		template<typename R>
+		inline R reduce(R initial, ReducerIndex<R> todo) const {
+			return this->reduce<R, ReducerIndex<R>&>(initial, todo);
 		}
 
 		template<typename R>
 		inline R reduce(R initial, Reducer<R> todo) const {
-			return reduce<R>(initial, [&todo](R result, T item, size_t) {
-				return todo(result, item);
-			});
+			return this->reduce<R, Reducer<R>&>(initial, todo);
 		}
 
-		Strong<Data<T>> filter(const TesterIndex& test) const {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		Strong<Data<T>> filter(F&& test) const {
 			Strong<Data<T>> result;
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				if (test(this->_get(idx), idx)) result->append(this->_get(idx));
@@ -546,14 +879,27 @@ namespace foundation::types {
 			return result;
 		}
 
+		template<typename F>
+		requires std::predicate<F&, T&>
+		Strong<Data<T>> filter(F&& test) const {
+			Strong<Data<T>> result;
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				if (test(this->_get(idx))) result->append(this->_get(idx));
+			}
+			return result;
+		}
+
+		inline Strong<Data<T>> filter(const TesterIndex& test) const {
+			return this->filter<const TesterIndex&>(test);
+		}
+
 		inline Strong<Data<T>> filter(const Tester& test) const {
-			return filter([&test](T item, const size_t) {
-				return test(item);
-			});
+			return this->filter<const Tester&>(test);
 		}
 
-		template<typename O>
-		Strong<Data<O>> map(const function<O(T item, size_t idx)>& transform) const {
+		template<typename O, typename F>
+		requires std::invocable<F&, T&, size_t>
+		Strong<Data<O>> map(F&& transform) const {
 			Strong<Data<O>> result;
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				result->append(transform(this->_get(idx), idx));
@@ -561,15 +907,29 @@ namespace foundation::types {
 			return result;
 		}
 
+		template<typename O, typename F>
+		requires std::invocable<F&, T&>
+		Strong<Data<O>> map(F&& transform) const {
+			Strong<Data<O>> result;
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				result->append(transform(this->_get(idx)));
+			}
+			return result;
+		}
+
 		template<typename O>
-		inline Strong<Data<O>> map(const function<O(T item)>& transform) const {
-			return map<O>([&transform](T item, const size_t) {
-				return transform(item);
-			});
+		inline Strong<Data<O>> map(const function<O(T item, size_t idx)>& transform) const {
+			return this->map<O, const function<O(T item, size_t idx)>&>(transform);
 		}
 
 		template<typename O>
-		Strong<Array<O>> mapToArray(const function<O(T item, size_t idx)>& transform) const {
+		inline Strong<Data<O>> map(const function<O(T item)>& transform) const {
+			return this->map<O, const function<O(T item)>&>(transform);
+		}
+
+		template<typename O, typename F>
+		requires std::invocable<F&, T&, size_t>
+		Strong<Array<O>> mapToArray(F&& transform) const {
 			Strong<Array<O>> result;
 			for (size_t idx = 0 ; idx < this->length(); idx++) {
 				result->append(transform(this->_get(idx), idx));
@@ -577,14 +937,29 @@ namespace foundation::types {
 			return result;
 		}
 
+		template<typename O, typename F>
+		requires std::invocable<F&, T&>
+		Strong<Array<O>> mapToArray(F&& transform) const {
+			Strong<Array<O>> result;
+			for (size_t idx = 0 ; idx < this->length(); idx++) {
+				result->append(transform(this->_get(idx)));
+			}
+			return result;
+		}
+
 		template<typename O>
-		Strong<Array<O>> mapToArray(const function<O(T item)>& transform) const {
-			return mapToArray<O>([&transform](T item, const size_t) {
-				return transform(item);
-			});
+		inline Strong<Array<O>> mapToArray(const function<O(T item, size_t idx)>& transform) const {
+			return this->mapToArray<O, const function<O(T item, size_t idx)>&>(transform);
+		}
+
+		template<typename O>
+		inline Strong<Array<O>> mapToArray(const function<O(T item)>& transform) const {
+			return this->mapToArray<O, const function<O(T item)>&>(transform);
 		}
 
-		bool some(const TesterIndex& test, bool def = false) const {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		bool some(F&& test, bool def = false) const {
 			if (this->length() == 0) return def;
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				if (test(this->_get(idx), idx)) return true;
@@ -592,32 +967,178 @@ namespace foundation::types {
 			return false;
 		}
 
+		template<typename F>
+		requires std::predicate<F&, T&>
+		bool some(F&& test, bool def = false) const {
+			if (this->length() == 0) return def;
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				if (test(this->_get(idx))) return true;
+			}
+			return false;
+		}
+
+		inline bool some(const TesterIndex& test, bool def = false) const {
+			return this->some<const TesterIndex&>(test, def);
+		}
+
 		inline bool some(const Tester& test, bool def = false) const {
-			return some([&test](T item, const size_t) {
-				return test(item);
-			}, def);
+			return this->some<const Tester&>(test, def);
 		}
 
-		bool every(const TesterIndex& test, bool def = true) const {
+		template<typename F>
+		requires std::predicate<F&, T&, size_t>
+		bool every(F&& test, bool def = true) const {
 			if (this->length() == 0) return def;
-			return !this->some([&test](T item, const size_t idx) {
-				return !test(item, idx);
-			});
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				if (!test(this->_get(idx), idx)) return false;
+			}
+			return true;
+		}
+
+		template<typename F>
+		requires std::predicate<F&, T&>
+		bool every(F&& test, bool def = true) const {
+			if (this->length() == 0) return def;
+			for (size_t idx = 0 ; idx < this->length() ; idx++) {
+				if (!test(this->_get(idx))) return false;
+			}
+			return true;
+		}
+
+		inline bool every(const TesterIndex& test, bool def = true) const {
+			return this->every<const TesterIndex&>(test, def);
 		}
 
 		inline bool every(const Tester& test, bool def = true) const {
-			return every([&test](T item, const size_t) {
-				return test(item);
-			}, def);
+			return this->every<const Tester&>(test, def);
+		}
+
+		// The parallel algorithms split the items into partitions of `grain`
+		// items and process them on several threads (see `Parallel`), so the
+		// callables must be safe to call concurrently. Results are merged in
+		// partition order. Callables may take the item, or the item and its index.
+
+		template<typename F>
+		requires std::invocable<F&, T&, size_t> || std::invocable<F&, T&>
+		void parallelForEach(F&& todo, size_t grain = FOUNDATION_PARALLEL_GRAIN_SIZE) const noexcept(false) {
+			T* items = this->length() > 0 ? this->_items() : nullptr;
+			Parallel::forEachPartition(this->length(), grain, [items,&todo](size_t, size_t start, size_t end) {
+				for (size_t idx = start ; idx < end ; idx++) {
+					_call(todo, items[idx], idx);
+				}
+			});
+		}
+
+		template<typename O, typename F>
+		requires std::invocable<F&, T&, size_t> || std::invocable<F&, T&>
+		Strong<Data<O>> parallelMap(F&& transform, size_t grain = FOUNDATION_PARALLEL_GRAIN_SIZE) const noexcept(false) {
+			Strong<Data<O>> result(this->length());
+			if (this->length() == 0) return result;
+			T* items = this->_items();
+			O* destination = result->_items();
+			Parallel::forEachPartition(this->length(), grain, [items,destination,&transform](size_t, size_t start, size_t end) {
+				for (size_t idx = start ; idx < end ; idx++) {
+					new (&destination[idx]) O(_call(transform, items[idx], idx));
+				}
+			});
+			result->_length = this->length();
+			return result;
+		}
+
+		// Kept items are first compacted within their own partition, and the
+		// partitions are then moved together in order.
+		template<typename F>
+		requires std::predicate<F&, T&, size_t> || std::predicate<F&, T&>
+		Strong<Data<T>> parallelFilter(F&& test, size_t grain = FOUNDATION_PARALLEL_GRAIN_SIZE) const noexcept(false) {
+
+			Strong<Data<T>> result(this->length());
+
+			if (this->length() == 0) return result;
+
+			size_t partitions = Parallel::partitions(this->length(), grain);
+			Data<size_t> counts(partitions, 0);
+
+			T* items = this->_items();
+			T* destination = result->_items();
+			size_t* kept = counts._items();
+
+			Parallel::forEachPartition(this->length(), grain, [items,destination,kept,&test](size_t partition, size_t start, size_t end) {
+				size_t count = 0;
+				for (size_t idx = start ; idx < end ; idx++) {
+					if (_call(test, items[idx], idx)) destination[start + count++] = items[idx];
+				}
+				kept[partition] = count;
+			});
+
+			size_t length = 0;
+
+			for (size_t partition = 0 ; partition < partitions ; partition++) {
+				size_t start = partition * math::max<size_t>(1, grain);
+				if (start != length) {
+					if constexpr (_isTriviallyCopyable) {
+						memmove(destination + length, destination + start, sizeof(T) * kept[partition]);
+					} else {
+						for (size_t idx = 0 ; idx < kept[partition] ; idx++) {
+							destination[length + idx] = destination[start + idx];
+						}
+					}
+				}
+				length += kept[partition];
+			}
+
+			result->_length = length;
+
+			if (length < this->length() / 2) result->shrinkToFit();
+
+			return result;
+
+		}
+
+		// Each partition is reduced from `initial`, and the partial results are
+		// combined in order using `combiner`. `initial` must therefore be an
+		// identity of the reduction – such as zero for sums.
+		template<typename R, typename F, typename C>
+		requires std::invocable<F&, R, T&> && std::invocable<C&, R, R&>
+		R parallelReduce(R initial, F&& reducer, C&& combiner, size_t grain = FOUNDATION_PARALLEL_GRAIN_SIZE) const noexcept(false) {
+
+			size_t partitions = Parallel::partitions(this->length(), grain);
+
+			if (partitions == 0) return initial;
+
+			Data<R> partials(partitions, initial);
+
+			T* items = this->_items();
+			R* results = partials._items();
+
+			Parallel::forEachPartition(this->length(), grain, [items,results,&initial,&reducer](size_t partition, size_t start, size_t end) {
+				R result = initial;
+				for (size_t idx = start ; idx < end ; idx++) {
+					result = reducer(result, items[idx]);
+				}
+				results[partition] = result;
+			});
+
+			R result = results[0];
+
+			for (size_t partition = 1 ; partition < partitions ; partition++) {
+				result = combiner(result, results[partition]);
+			}
+
+			return result;
+
 		}
 
 		virtual uint64_t hash() const override {
 			if (_hashIsDirty) {
-				Hashable::Builder builder;
-				for (size_t idx = 0 ; idx < this->length() ; idx++) {
-					builder.add(this->hashForItem(this->_get(idx)));
+				if constexpr (_isBitwiseComparable) {
+					_hash = Hashable::hashBytes(this->items(), sizeof(T) * this->length());
+				} else {
+					Hashable::Builder builder;
+					for (size_t idx = 0 ; idx < this->length() ; idx++) {
+						builder.add(this->hashForItem(this->_get(idx)));
+					}
+					_hash = builder;
 				}
-				_hash = builder;
 				_hashIsDirty = false;
 			}
 			return _hash;
@@ -634,6 +1155,10 @@ namespace foundation::types {
 
 		bool equals(const Data<T>& other) const {
 			if (this->length() != other.length()) return false;
+			if (this->length() == 0) return true;
+			if constexpr (_isBitwiseComparable) {
+				return memcmp(this->items(), other.items(), sizeof(T) * this->length()) == 0;
+			}
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				if (this->_get(idx) != other._get(idx)) return false;
 			}
@@ -650,6 +1175,12 @@ namespace foundation::types {
 		}
 
 		virtual bool greaterThan(const Data<T>& other) const override {
+			if constexpr (_isBytewiseOrdered) {
+				size_t length = math::min(this->length(), other.length());
+				int result = length > 0 ? memcmp(this->items(), other.items(), length) : 0;
+				if (result != 0) return result > 0;
+				return this->length() > other.length();
+			}
 			for (size_t idx = 0 ; idx < this->length() ; idx++) {
 				if (idx >= other.length()) return true;
 				T left = this->_get(idx);
@@ -661,11 +1192,16 @@ namespace foundation::types {
 		}
 
 		Data& operator=(const Data<T>& other) {
+			if (this == &other) return *this;
+			other._flatten();
+			delete this->_chunks;
+			this->_chunks = nullptr;
 			Storage::release(&this->_storage);
-			this->_storage = other._storage->retain();
 			this->_length = other._length;
 			this->_size = other._size;
-			this->_offset = other._offset;
+			this->_growth = other._growth;
+			this->_offset = 0;
+			this->_share(other, 0, other._length);
 			this->_hashIsDirty = other._hashIsDirty;
 			this->_hash = other._hash;
 			Type::operator=(other);
@@ -673,11 +1209,17 @@ namespace foundation::types {
 		}
 
 		Data& operator=(Data<T>&& other) {
+			if (this == &other) return *this;
+			delete this->_chunks;
+			this->_chunks = other._chunks;
+			other._chunks = nullptr;
 			Storage::release(&this->_storage);
 			this->_storage = other._storage;
 			this->_length = other._length;
 			this->_size = other._size;
+			this->_growth = other._growth;
 			this->_offset = other._offset;
+			if (this->_storage == nullptr) this->_takeInline(other, 0, this->_headLength());
 			this->_hashIsDirty = other._hashIsDirty;
 			this->_hash = other._hash;
 			other._storage = nullptr;
@@ -697,6 +1239,11 @@ namespace foundation::types {
 
 	private:
 
+		template<typename>
+		friend class Data;
+
+		friend class DataBuilder<T>;
+
 		class Storage : public Allocator {
 
 		public:
@@ -704,25 +1251,40 @@ namespace foundation::types {
 			Storage(const Storage&) = delete;
 			Storage(Storage&&) = delete;
 
-			Storage(const size_t length = 0) : _ptr(nullptr), _length(0), _retainCount(1) {
-				this->ensureStorageSize(length);
+			Storage(const size_t length = 0, Growth growth = Growth::twice) : _ptr(nullptr), _length(0), _mappedSize(0), _retainCount(1) {
+				this->ensureStorageSize(length, growth);
+			}
+
+			static Storage* map(int descriptor, size_t size) noexcept(false) {
+				T* ptr = (T*)Allocator::mapFile(descriptor, size);
+				Storage* result = new Storage();
+				result->_ptr = ptr;
+				result->_length = size / sizeof(T);
+				result->_mappedSize = size;
+				return result;
 			}
 
 			~Storage() {
-				if (this->_ptr != nullptr) {
-					free(this->_ptr);
+				if (this->_mappedSize > 0) {
+					Allocator::unmapFile(this->_ptr, this->_mappedSize);
+					this->_ptr = nullptr;
+				} else if (this->_ptr != nullptr) {
+#ifdef FOUNDATION_MEMORY_STATISTICS
+					Statistics::storageResized(sizeof(T) * this->_length, 0);
+#endif
+					Allocator::deallocateBuffer(this->_ptr, sizeof(T) * this->_length);
 					this->_ptr = nullptr;
 				}
 			}
 
 			Storage* retain() const {
-				this->_retainCount++;
+				Counter<CountingPolicy<Data<T>>::value>::increment(this->_retainCount);
 				return (Storage*)this;
 			}
 
-			static bool own(Storage** store, size_t length, size_t offset = 0) {
+			static bool own(Storage** store, size_t length, size_t offset = 0, Growth growth = Growth::twice) {
 				bool replaced = false;
-				if (*store != nullptr) *store = (*store)->own(length, offset, &replaced);
+				if (*store != nullptr) *store = (*store)->own(length, offset, growth, &replaced);
 				return replaced;
 			}
 
@@ -730,37 +1292,43 @@ namespace foundation::types {
 				if (*store != nullptr) *store = (*store)->release();
 			}
 
-			inline T& get(size_t index) const {
-				return this->_ptr[index];
-			}
-
-			inline T& set(size_t index, const T& value) {
-				return this->_ptr[index] = value;
-			}
-
 			inline operator T*() const {
 				return this->_ptr;
 			}
 
-			void ensureStorageSize(size_t length) {
+			inline size_t capacity() const {
+				return this->_length;
+			}
+
+			void ensureStorageSize(size_t length, Growth growth = Growth::twice) {
 				if (this->_length < length) {
-					this->_length = Allocator::calculateBufferLength(length);
-					this->_ptr = (T*) realloc(this->_ptr, sizeof(T) * this->_length);
+					this->resize(Allocator::calculateBufferLength(length, this->_length, growth));
 				}
 			}
 
+			void resize(size_t length) {
+				if (this->_length == length) return;
+				this->_ptr = (T*)Allocator::reallocateBuffer(this->_ptr, sizeof(T) * this->_length, sizeof(T) * length);
+#ifdef FOUNDATION_MEMORY_STATISTICS
+				Statistics::storageResized(sizeof(T) * this->_length, sizeof(T) * length);
+#endif
+				this->_length = length;
+			}
+
 		private:
 
-			Storage* own(size_t length, size_t offset, bool* replaced) const {
+			Storage* own(size_t length, size_t offset, Growth growth, bool* replaced) const {
 				*replaced = false;
-				if (this->_retainCount == 1) return (Storage*)this;
+				// Mapped files are read-only, so they are never owned in place.
+				if (this->_mappedSize == 0 && Counter<CountingPolicy<Data<T>>::value>::load(this->_retainCount) == 1) return (Storage*)this;
+				Storage* result = new Storage(*this, offset, length, growth);
 				this->release();
 				*replaced = true;
-				return new Storage(*this, offset, length);
+				return result;
 			}
 
 			Storage* release() const {
-				if (--this->_retainCount == 0) {
+				if (Counter<CountingPolicy<Data<T>>::value>::decrement(this->_retainCount) == 0) {
 					delete(this);
 				}
 				return nullptr;
@@ -768,33 +1336,205 @@ namespace foundation::types {
 
 			T* _ptr;
 			size_t _length;
+			size_t _mappedSize;
 			mutable std::atomic<size_t> _retainCount;
 
-			Storage(const Storage& other, size_t offset, size_t length) : Storage(length) {
-				for (size_t idx = 0 ; idx < length ; idx++) {
-					this->_ptr[idx] = other._ptr[idx + offset];
+			Storage(const Storage& other, size_t offset, size_t length, Growth growth) : Storage(length, growth) {
+				if constexpr (_isTriviallyCopyable) {
+					if (length > 0) memcpy(this->_ptr, other._ptr + offset, sizeof(T) * length);
+				} else {
+					for (size_t idx = 0 ; idx < length ; idx++) {
+						this->_ptr[idx] = other._ptr[idx + offset];
+					}
 				}
 			}
 
 		};
 
+		static constexpr bool _isTriviallyCopyable = std::is_trivially_copyable<T>::value;
+		static constexpr size_t _inlineCapacity = FOUNDATION_DATA_INLINE_SIZE / sizeof(T);
+		static constexpr bool _isBitwiseComparable = std::has_unique_object_representations<T>::value;
+		static constexpr bool _isBytewiseOrdered = std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) == 1;
+
 		Storage* _storage;
 		size_t _offset;
 		size_t _length;
 		size_t _size;
+		Growth _growth;
 		mutable bool _hashIsDirty;
 		mutable uint64_t _hash;
 
+		// Short payloads are kept here, and `_storage` is null, until they
+		// outgrow it.
+		alignas(T) uint8_t _inline[FOUNDATION_DATA_INLINE_SIZE];
+
+		struct Chunk {
+			Data<T> data;
+			Chunk* next;
+		};
+
+		struct Chunks {
+
+			Chunk* first = nullptr;
+			Chunk* last = nullptr;
+			size_t length = 0;
+			bool isLastWritable = false;
+
+			~Chunks() {
+				while (this->first != nullptr) {
+					Chunk* next = this->first->next;
+					delete this->first;
+					this->first = next;
+				}
+			}
+
+		};
+
+		// Only allocated in chunked mode. Items in chunks follow the items in
+		// `_storage`, and are included in `_length`.
+		Chunks* _chunks;
+
+		inline size_t _headLength() const {
+			if (this->_chunks == nullptr) return this->_length;
+			return this->_length - this->_chunks->length;
+		}
+
+		void _appendChunk(Chunk* chunk, bool isWritable) {
+			chunk->next = nullptr;
+			if (this->_chunks->last != nullptr) this->_chunks->last->next = chunk;
+			else this->_chunks->first = chunk;
+			this->_chunks->last = chunk;
+			this->_chunks->isLastWritable = isWritable;
+		}
+
+		void _appendChunk(const Data<T>& data) {
+			if (data.length() == 0) return;
+			this->_appendChunk(new Chunk { data, nullptr }, false);
+			this->_chunks->length += data.length();
+			this->_length += data.length();
+			this->_hashIsDirty = true;
+		}
+
+		void _appendChunk(const T* items, size_t length) {
+			Chunk* last = this->_chunks->last;
+			if (!this->_chunks->isLastWritable || last->data.capacity() - last->data.length() < length) {
+				last = new Chunk();
+				last->data.reserve(math::max<size_t>(length, FOUNDATION_DATA_CHUNK_SIZE / sizeof(T)));
+				this->_appendChunk(last, true);
+			}
+			// Writable chunks are never shared and have room, so copy straight in.
+			this->_copyItems(last->data._items() + last->data._length, items, length);
+			last->data._length += length;
+			this->_chunks->length += length;
+			this->_length += length;
+			this->_hashIsDirty = true;
+		}
+
+		void _flatten() const {
+			if (this->_chunks == nullptr || this->_chunks->first == nullptr) return;
+			Data<T>* self = (Data<T>*)this;
+			Chunk* chunk = self->_chunks->first;
+			size_t length = self->_length;
+			self->_length = self->_headLength();
+			self->_chunks->first = self->_chunks->last = nullptr;
+			self->_chunks->length = 0;
+			self->_chunks->isLastWritable = false;
+			self->_ensureStorageSize(length, Growth::exact);
+			T* items = self->_items();
+			while (chunk != nullptr) {
+				Chunk* next = chunk->next;
+				self->_copyItems(items + self->_length, chunk->data.items(), chunk->data.length());
+				self->_length += chunk->data.length();
+				delete chunk;
+				chunk = next;
+			}
+		}
+
 		void _ensureStorageSize(size_t length) {
-			if (this->_storage == nullptr) this->_storage = new Storage(length);
-			else {
+			this->_ensureStorageSize(length, this->_growth);
+		}
+
+		void _ensureStorageSize(size_t length, Growth growth) {
+			this->_flatten();
+			if (this->_storage == nullptr) {
+				if (this->_offset + length <= _inlineCapacity) return;
+				if (length <= _inlineCapacity) return this->_compact();
+				Storage* storage = new Storage(length, growth);
+				this->_copyItems(*storage, this->_items(), this->_length);
+				this->_storage = storage;
+				this->_offset = 0;
+			} else {
 				this->_ensureStorageOwnership();
-				this->_storage->ensureStorageSize(length);
+				// Reclaim space left at the front by removals before growing.
+				if (this->_offset > 0 && this->_offset + length > this->_storage->capacity() && this->_offset >= this->_storage->capacity() / 2) {
+					this->_compact();
+				}
+				this->_storage->ensureStorageSize(this->_offset + length, growth);
 			}
 		}
 
+		void _compact() {
+			T* items = this->_buffer();
+			if constexpr (_isTriviallyCopyable) {
+				memmove(items, items + this->_offset, sizeof(T) * this->_length);
+			} else {
+				for (size_t idx = 0 ; idx < this->_length ; idx++) {
+					items[idx] = items[this->_offset + idx];
+				}
+			}
+			this->_offset = 0;
+		}
+
+		inline T* _buffer() const {
+			if (this->_storage == nullptr) return (T*)this->_inline;
+			return *this->_storage;
+		}
+
+		inline T* _base() const {
+			this->_flatten();
+			return this->_buffer();
+		}
+
+		inline T* _items() const {
+			return this->_base() + this->_offset;
+		}
+
+		inline size_t _capacity() const {
+			if (this->_storage == nullptr) return _inlineCapacity;
+			return this->_storage->capacity();
+		}
+
+		static inline void _copyItems(T* destination, const T* source, size_t length) {
+			if constexpr (_isTriviallyCopyable) {
+				if (length > 0) memcpy(destination, source, sizeof(T) * length);
+			} else {
+				for (size_t idx = 0 ; idx < length ; idx++) {
+					destination[idx] = source[idx];
+				}
+			}
+		}
+
+		void _takeInline(const Data<T>& other, size_t offset, size_t length) {
+			this->_copyItems((T*)this->_inline, other._buffer() + other._offset + offset, length);
+			this->_offset = 0;
+		}
+
+		void _share(const Data<T>& other, size_t offset, size_t length) {
+			other._flatten();
+			if (other._storage == nullptr || length <= _inlineCapacity) return this->_takeInline(other, offset, length);
+			size_t capacity = other._storage->capacity();
+			if (sizeof(T) * capacity >= FOUNDATION_DATA_COMPACTION_THRESHOLD && length * FOUNDATION_DATA_COMPACTION_RATIO < capacity) {
+				this->_storage = new Storage(length, Growth::exact);
+				this->_copyItems(*this->_storage, other._buffer() + other._offset + offset, length);
+				return;
+			}
+			this->_storage = other._storage->retain();
+			this->_offset = other._offset + offset;
+		}
+
 		inline void _ensureStorageOwnership() {
-			if (Storage::own(&this->_storage, this->_length, this->_offset)) {
+			this->_flatten();
+			if (Storage::own(&this->_storage, this->_length, this->_offset, this->_growth)) {
 				this->_offset = 0;
 			}
 		}
@@ -804,11 +1544,89 @@ namespace foundation::types {
 		}
 
 		inline T& _get(size_t index) const {
-			return this->_storage->get(this->_index(index));
+			return this->_base()[this->_index(index)];
 		}
 
 		inline T& _set(size_t index, const T& value) {
-			return this->_storage->set(this->_index(index), value);
+			return this->_base()[this->_index(index)] = value;
+		}
+
+		template<typename F>
+		static inline decltype(auto) _call(F& todo, T& item, size_t idx) {
+			if constexpr (std::invocable<F&, T&, size_t>) return todo(item, idx);
+			else return todo(item);
+		}
+
+		using _Match = typename MultiSearch<T>::Match;
+
+		template<typename F>
+		Strong<Array<Data<T>>> _split(IncludeSeparator includeSeparator, size_t max, F&& next) const {
+
+			Strong<Array<Data<T>>> result;
+
+			size_t idx = 0;
+			size_t offset = 0;
+
+			while (result->count() < max - 1) {
+
+				_Match match = next(offset);
+
+				if (match.index == NotFound) break;
+
+				switch (includeSeparator) {
+					case IncludeSeparator::none:
+					case IncludeSeparator::prefix:
+						result->append(this->subdata(idx, match.index - idx));
+						break;
+					case IncludeSeparator::suffix:
+					case IncludeSeparator::both:
+						result->append(this->subdata(idx, match.index + match.length - idx));
+						break;
+				}
+
+				switch (includeSeparator) {
+					case IncludeSeparator::none:
+					case IncludeSeparator::suffix:
+						idx = match.index + match.length;
+						break;
+					case IncludeSeparator::prefix:
+					case IncludeSeparator::both:
+						idx = match.index;
+						break;
+				}
+
+				offset = match.index + match.length;
+
+			}
+
+			result->append(this->subdata(idx, this->length() - idx));
+
+			return result;
+
+		}
+
+		template<typename F>
+		Strong<Data<T>> _replacing(const Data<T>& replacement, F&& next) const {
+
+			_Match match = next(0);
+
+			if (match.index == NotFound) return Strong<Data<T>>(*this);
+
+			Strong<Data<T>> result;
+
+			size_t idx = 0;
+
+			while (match.index != NotFound) {
+				result->append(this->items() + idx, match.index - idx);
+				result->append(replacement);
+				idx = match.index + match.length;
+				match = next(idx);
+			}
+
+			result->append(this->items() + idx, this->length() - idx);
+
+			return result;
+
 		}
 
 	};
@@ -844,6 +1662,67 @@ namespace foundation::types {
 
 	};
 
+	// Builds data in place on the heap. `reserve` hands out a writable region
+	// at the end of the buffer, and the first `commit`ted items of it become
+	// part of the data. `build` hands the buffer to a `Data` without copying.
+	//
+	//     DataBuilder<uint8_t> builder;
+	//     builder.commit(fread(builder.reserve(4096), 1, 4096, stream));
+	//     Data<uint8_t> data = builder.build();
+	template<typename T = uint8_t>
+	class DataBuilder {
+
+	public:
+
+		DataBuilder(size_t capacity = 0) : _data(capacity), _reserved(0) {}
+
+		DataBuilder(const DataBuilder<T>&) = delete;
+		DataBuilder(DataBuilder<T>&&) = delete;
+
+		inline size_t length() const {
+			return this->_data._length;
+		}
+
+		// The region is valid until the next call to the builder.
+		T* reserve(size_t length) {
+			this->_data._ensureStorageSize(this->_data._length + length);
+			this->_reserved = length;
+			return this->_data._items() + this->_data._length;
+		}
+
+		void commit(size_t length) noexcept(false) {
+			if (length > this->_reserved) throw OutOfBoundException(length);
+			this->_data._length += length;
+			this->_data._hashIsDirty = true;
+			this->_reserved = 0;
+		}
+
+		void append(const T* items, size_t length) {
+			Data<T>::_copyItems(this->reserve(length), items, length);
+			this->commit(length);
+		}
+
+		inline void append(const Data<T>& data) {
+			data.forEachChunk([this](const T* items, size_t length) {
+				this->append(items, length);
+			});
+		}
+
+		// Leaves the builder empty.
+		Data<T> build() {
+			Data<T> result(std::move(this->_data));
+			this->_data = Data<T>();
+			this->_reserved = 0;
+			return result;
+		}
+
+	private:
+
+		Data<T> _data;
+		size_t _reserved;
+
+	};
+
 }
 
 #endif /* foundation_data_hpp */
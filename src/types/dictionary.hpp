@@ -57,6 +57,25 @@ namespace foundation::types {
 
 		virtual ~Dictionary() {}
 
+		virtual bool isCollectable() const override {
+			return true;
+		}
+
+		virtual size_t retainedCount() const override {
+			return _keys.retainedCount() + _values.retainedCount();
+		}
+
+		virtual const Object* lockRetainedAt(size_t index) const override {
+			size_t keys = _keys.retainedCount();
+			if (index < keys) return _keys.lockRetainedAt(index);
+			return _values.lockRetainedAt(index - keys);
+		}
+
+		virtual void releaseRetained() override {
+			_keys = Array<Key>();
+			_values = Array<Value>();
+		}
+
 		void set(Strong<Key> key, Strong<Value> value) {
 			size_t index = _keys.indexOf(key);
 			if (index != NotFound) {
@@ -146,12 +165,18 @@ namespace foundation::types {
 			});
 		}
 
-		void forEach(const function<void(const Pair<Key, Value>&)>& todo) const {
+		template<typename F>
+		requires std::invocable<F&, const Pair<Key, Value>&>
+		void forEach(F&& todo) const {
 			for (size_t idx = 0 ; idx < _keys.count() ; idx++) {
 				todo(Pair<Key, Value>(_keys[idx], _values[idx]));
 			}
 		}
 
+		inline void forEach(const function<void(const Pair<Key, Value>&)>& todo) const {
+			this->forEach<const function<void(const Pair<Key, Value>&)>&>(todo);
+		}
+
 		template<typename OtherValue>
 		OtherValue transformValue(const Key& key, const function<OtherValue(Value&)>& todo) const {
 			if (!this->hasKey(key)) return nullptr;
@@ -164,7 +189,9 @@ namespace foundation::types {
 			});
 		}
 
-		Strong<Dictionary<Key, Value>> filter(const function<bool(const Pair<Key, Value>&)>& todo) const {
+		template<typename F>
+		requires std::predicate<F&, const Pair<Key, Value>&>
+		Strong<Dictionary<Key, Value>> filter(F&& todo) const {
 			Strong<Dictionary<Key, Value>> result;
 			for (size_t idx = 0 ; idx < this->_keys.count() ; idx++) {
 				Strong<Key> key = this->_keys[idx];
@@ -174,43 +201,71 @@ namespace foundation::types {
 			return result;
 		}
 
-		template<typename OtherKey>
-		Strong<Dictionary<OtherKey, Value>> mapKeys(const function<Strong<OtherKey>(const Pair<Key, Value>&, size_t)>& todo) const {
+		inline Strong<Dictionary<Key, Value>> filter(const function<bool(const Pair<Key, Value>&)>& todo) const {
+			return this->filter<const function<bool(const Pair<Key, Value>&)>&>(todo);
+		}
+
+		template<typename OtherKey, typename F>
+		requires std::invocable<F&, const Pair<Key, Value>&, size_t>
+		Strong<Dictionary<OtherKey, Value>> mapKeys(F&& todo) const {
 			Strong<Dictionary<OtherKey, Value>> result;
-			this->_keys.forEach([&todo,&result,this](Key& key, size_t idx) {
-				Strong<Value> value = this->get(key);
-				result->set(todo(Strong<Pair<Key, Value>>(key, value), idx), value);
-			});
+			for (size_t idx = 0 ; idx < this->_keys.count() ; idx++) {
+				Strong<Value> value = this->_values[idx];
+				result->set(todo(Pair<Key, Value>(this->_keys[idx], value), idx), value);
+			}
 			return result;
 		}
 
-		template<typename OtherKey>
-		Strong<Dictionary<OtherKey, Value>> mapKeys(const function<Strong<OtherKey>(const Pair<Key, Value>&)>& todo) const {
+		template<typename OtherKey, typename F>
+		requires std::invocable<F&, const Pair<Key, Value>&>
+		Strong<Dictionary<OtherKey, Value>> mapKeys(F&& todo) const {
 			return this->mapKeys<OtherKey>([&todo](const Pair<Key, Value>& pair, size_t) {
 				return todo(pair);
 			});
 		}
 
-		template<typename OtherValue>
-		Strong<Dictionary<Key, OtherValue>> mapValues(const function<Strong<OtherValue>(const Pair<Key, Value>&, size_t)>& todo) const {
+		template<typename OtherKey>
+		inline Strong<Dictionary<OtherKey, Value>> mapKeys(const function<Strong<OtherKey>(const Pair<Key, Value>&, size_t)>& todo) const {
+			return this->mapKeys<OtherKey, const function<Strong<OtherKey>(const Pair<Key, Value>&, size_t)>&>(todo);
+		}
+
+		template<typename OtherKey>
+		inline Strong<Dictionary<OtherKey, Value>> mapKeys(const function<Strong<OtherKey>(const Pair<Key, Value>&)>& todo) const {
+			return this->mapKeys<OtherKey, const function<Strong<OtherKey>(const Pair<Key, Value>&)>&>(todo);
+		}
+
+		template<typename OtherValue, typename F>
+		requires std::invocable<F&, const Pair<Key, Value>&, size_t>
+		Strong<Dictionary<Key, OtherValue>> mapValues(F&& todo) const {
 			Strong<Dictionary<Key, OtherValue>> result;
-			this->_keys.forEach([&todo,&result,this](Key& key, size_t idx) {
-				Strong<Value> value = this->get(key);
-				result->set(key, todo(Strong<Pair<Key, Value>>(key, value), idx));
-			});
+			for (size_t idx = 0 ; idx < this->_keys.count() ; idx++) {
+				Strong<Key> key = this->_keys[idx];
+				result->set(key, todo(Pair<Key, Value>(key, this->_values[idx]), idx));
+			}
 			return result;
 		}
 
-		template<typename OtherValue>
-		Strong<Dictionary<Key, OtherValue>> mapValues(const function<Strong<OtherValue>(const Pair<Key, Value>&)>& todo) const {
+		template<typename OtherValue, typename F>
+		requires std::invocable<F&, const Pair<Key, Value>&>
+		Strong<Dictionary<Key, OtherValue>> mapValues(F&& todo) const {
 			return this->mapValues<OtherValue>([&todo](const Pair<Key, Value>& pair, size_t) {
 				return todo(pair);
 			});
 		}
 
+		template<typename OtherValue>
+		inline Strong<Dictionary<Key, OtherValue>> mapValues(const function<Strong<OtherValue>(const Pair<Key, Value>&, size_t)>& todo) const {
+			return this->mapValues<OtherValue, const function<Strong<OtherValue>(const Pair<Key, Value>&, size_t)>&>(todo);
+		}
 
 		template<typename OtherValue>
-		Strong<Array<OtherValue>> map(const function<Strong<OtherValue>(const Pair<Key, Value>&)> todo) const {
+		inline Strong<Dictionary<Key, OtherValue>> mapValues(const function<Strong<OtherValue>(const Pair<Key, Value>&)>& todo) const {
+			return this->mapValues<OtherValue, const function<Strong<OtherValue>(const Pair<Key, Value>&)>&>(todo);
+		}
+
+		template<typename OtherValue, typename F>
+		requires std::invocable<F&, const Pair<Key, Value>&>
+		Strong<Array<OtherValue>> map(F&& todo) const {
 			Strong<Array<OtherValue>> result;
 			this->forEach([&todo,&result](const Pair<Key, Value>& element) {
 				result->append(todo(element));
@@ -218,6 +273,11 @@ namespace foundation::types {
 			return result;
 		}
 
+		template<typename OtherValue>
+		inline Strong<Array<OtherValue>> map(const function<Strong<OtherValue>(const Pair<Key, Value>&)> todo) const {
+			return this->map<OtherValue, const function<Strong<OtherValue>(const Pair<Key, Value>&)>&>(todo);
+		}
+
 		Strong<Array<Pair<Key, Value>>> iterate() const {
 			return this->_keys.template map<Pair<Key, Value>>([&](Strong<Key> key, size_t idx) {
 				return Strong<Pair<Key, Value>>(key, this->_values[idx]);
@@ -6,17 +6,77 @@
 // See license in LICENSE.
 //
 
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <sys/random.h>
+#endif
+
 #include "hashable.hpp"
 
 using namespace foundation::types;
 using namespace foundation::tools;
 
-Hashable::Builder::Builder() : _hash(5381) { }
+static const uint64_t _secret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+static inline void _multiply(
+	uint64_t* a,
+	uint64_t* b
+) {
+	__uint128_t result = (__uint128_t)*a * *b;
+	*a = (uint64_t)result;
+	*b = (uint64_t)(result >> 64);
+}
+
+static inline uint64_t _mix(
+	uint64_t a,
+	uint64_t b
+) {
+	_multiply(&a, &b);
+	return a ^ b;
+}
+
+static inline uint64_t _read8(
+	const uint8_t* bytes
+) {
+	uint64_t result;
+	memcpy(&result, bytes, sizeof(result));
+	return result;
+}
+
+static inline uint64_t _read4(
+	const uint8_t* bytes
+) {
+	uint32_t result;
+	memcpy(&result, bytes, sizeof(result));
+	return result;
+}
+
+static inline uint64_t _read3(
+	const uint8_t* bytes,
+	size_t length
+) {
+	return ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[length >> 1] << 8) | bytes[length - 1];
+}
+
+static uint64_t _makeSeed() {
+#ifdef FOUNDATION_HASH_RANDOM_SEED
+	uint64_t result = 0;
+	if (getentropy(&result, sizeof(result)) != 0) result = (uint64_t)time(nullptr) ^ (uint64_t)(uintptr_t)&result;
+	return result;
+#else
+	return 0;
+#endif
+}
+
+Hashable::Builder::Builder() : _hash(_mix(Hashable::seed() ^ _secret[0], _secret[1])) { }
 
 Hashable::Builder& Hashable::Builder::add(
 	uint64_t value
 ) {
-	_hash = ((_hash << 5) + _hash) + (uint64_t)value;
+	_hash = _mix(_hash ^ _secret[0], value ^ _secret[1]);
 	return *this;
 }
 
@@ -40,10 +100,77 @@ Hashable::Builder& Hashable::Builder::add(
 	return this->add(hashable.hash());
 }
 
+Hashable::Builder& Hashable::Builder::add(
+	const void* bytes,
+	size_t length
+) {
+	return this->add(Hashable::hashBytes(bytes, length));
+}
+
 Hashable::Builder::operator uint64_t() {
 	return _hash;
 }
 
+uint64_t Hashable::hashBytes(
+	const void* bytes,
+	size_t length
+) {
+
+	const uint8_t* position = (const uint8_t*)bytes;
+	uint64_t seed = Hashable::seed();
+	uint64_t a;
+	uint64_t b;
+
+	seed ^= _mix(seed ^ _secret[0], _secret[1]);
+
+	if (length <= 16) {
+		if (length >= 4) {
+			a = (_read4(position) << 32) | _read4(position + ((length >> 3) << 2));
+			b = (_read4(position + length - 4) << 32) | _read4(position + length - 4 - ((length >> 3) << 2));
+		} else if (length > 0) {
+			a = _read3(position, length);
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		size_t remaining = length;
+		if (remaining >= 48) {
+			// Three independent lanes keep the multipliers busy.
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+			do {
+				seed = _mix(_read8(position) ^ _secret[1], _read8(position + 8) ^ seed);
+				seed1 = _mix(_read8(position + 16) ^ _secret[2], _read8(position + 24) ^ seed1);
+				seed2 = _mix(_read8(position + 32) ^ _secret[3], _read8(position + 40) ^ seed2);
+				position += 48;
+				remaining -= 48;
+			} while (remaining >= 48);
+			seed ^= seed1 ^ seed2;
+		}
+		while (remaining > 16) {
+			seed = _mix(_read8(position) ^ _secret[1], _read8(position + 8) ^ seed);
+			position += 16;
+			remaining -= 16;
+		}
+		a = _read8(position + remaining - 16);
+		b = _read8(position + remaining - 8);
+	}
+
+	a ^= _secret[1];
+	b ^= seed;
+
+	_multiply(&a, &b);
+
+	return _mix(a ^ _secret[0] ^ length, b ^ _secret[1]);
+
+}
+
+uint64_t Hashable::seed() {
+	static const uint64_t seed = _makeSeed();
+	return seed;
+}
+
 Hashable::Hashable() { }
 
 Hashable::Hashable(
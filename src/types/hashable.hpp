@@ -39,6 +39,10 @@ namespace foundation::types {
 				Builder& add(
 					const Hashable& hashable);
 
+				Builder& add(
+					const void* bytes,
+					size_t length);
+
 				operator uint64_t();
 
 			private:
@@ -47,6 +51,16 @@ namespace foundation::types {
 
 			};
 
+			// Hashes `length` bytes with a wyhash-style block hash. The result
+			// depends on `seed()`.
+			static uint64_t hashBytes(
+				const void* bytes,
+				size_t length);
+
+			// Zero, unless the library is built with
+			// `FOUNDATION_HASH_RANDOM_SEED`, in which case it is random per process.
+			static uint64_t seed();
+
 			Hashable();
 
 			Hashable(
@@ -84,20 +84,36 @@ String String::format(
 
 	va_start(args, format);
 
-	char buffer[size];
+	DataBuilder<uint8_t> builder(size);
 
-	vsnprintf(buffer, size, format, args);
+	vsnprintf((char*)builder.reserve(size), size, format, args);
 
 	va_end(args);
 
-	return String((const char*)buffer);
+	builder.commit(size);
+
+	return String(builder.build());
 
 }
 
 Strong<String> String::fromHex(
-	const Data<uint8_t>& data
+	const Data<uint8_t>& data,
+	bool uppercase
+) {
+	DataBuilder<uint32_t> builder;
+	hex::encode(data.items(), data.length(), builder.reserve(data.length() * 2), uppercase);
+	builder.commit(data.length() * 2);
+	return Strong<String>(builder.build());
+}
+
+Strong<String> String::fromBase64(
+	const Data<uint8_t>& data,
+	base64::Alphabet alphabet,
+	bool padding
 ) {
-	return Strong<String>(_decodeHex(data));
+	DataBuilder<uint32_t> builder;
+	builder.commit(base64::encode(data.items(), data.length(), builder.reserve(base64::encodedLength(data.length(), padding)), alphabet, padding));
+	return Strong<String>(builder.build());
 }
 
 Strong<String> String::join(
@@ -146,6 +162,40 @@ size_t String::length() const {
 	return _storage.length();
 }
 
+size_t String::capacity() const {
+	return _storage.capacity();
+}
+
+void String::reserve(
+	size_t capacity
+) {
+	_storage.reserve(capacity);
+}
+
+void String::shrinkToFit() {
+	_storage.shrinkToFit();
+}
+
+Growth String::growth() const {
+	return _storage.growth();
+}
+
+void String::setGrowth(
+	Growth growth
+) {
+	_storage.setGrowth(growth);
+}
+
+bool String::isChunked() const {
+	return _storage.isChunked();
+}
+
+void String::setChunked(
+	bool chunked
+) {
+	_storage.setChunked(chunked);
+}
+
 void String::withCString(
 	const function<void(const char*)>& todo
 ) const {
@@ -176,7 +226,32 @@ Strong<Data<uint32_t>> String::UTF32Data() const {
 }
 
 Strong<Data<uint8_t>> String::hexData() const {
-	return _encodeHex(_storage);
+
+	size_t length = this->_storage.length();
+
+	if (length % 2 != 0) throw OutOfBoundException(length + 1);
+
+	DataBuilder<uint8_t> builder;
+
+	hex::decode(this->_storage.items(), length, builder.reserve(length / 2));
+	builder.commit(length / 2);
+
+	return Strong<Data<uint8_t>>(builder.build());
+
+}
+
+Strong<Data<uint8_t>> String::base64Data(
+	base64::Alphabet alphabet
+) const {
+
+	size_t length = this->_storage.length();
+
+	DataBuilder<uint8_t> builder;
+
+	builder.commit(base64::decode(this->_storage.items(), length, builder.reserve(base64::maximumDecodedLength(length)), alphabet));
+
+	return Strong<Data<uint8_t>>(builder.build());
+
 }
 
 void String::append(
@@ -194,7 +269,7 @@ void String::append(
 Strong<String> String::appending(
 	const String& other
 ) const {
-	return String(this->_storage.appending(other._storage));
+	return Strong<String>(this->_storage.appending(other._storage)).autoreleased();
 }
 
 Strong<Array<String>> String::split() const {
@@ -239,7 +314,25 @@ Strong<String> String::replacing(
 	const String& needle,
 	const String& replacement
 ) const {
-	return String::join(this->split(needle), replacement);
+	return Strong<String>(this->_storage.replacing(needle._storage, replacement._storage)).autoreleased();
+}
+
+Strong<String> String::replacing(
+	const Array<String>& needles,
+	const String& replacement
+) const {
+
+	auto stores = needles.map<Data<uint32_t>>(
+		[](const String& current) {
+			return current._storage;
+		});
+
+	return Strong<String>(
+		this->_storage.replacing(
+			stores,
+			replacement._storage))
+		.autoreleased();
+
 }
 
 double String::doubleValue(
@@ -370,35 +463,35 @@ bool String::contains(
 bool String::hasSuffix(
 	const String& other
 ) const {
-	return this->_storage.hasPrefix(other._storage);
+	return this->_storage.hasSuffix(other._storage);
 }
 
 bool String::hasPrefix(
 	const String& other
 ) const {
-	return this->_storage.hasSuffix(other._storage);
+	return this->_storage.hasPrefix(other._storage);
 }
 
 Strong<String> String::substring(
 	size_t offset,
 	size_t length
 ) const {
-	return Strong<String>(_storage.subdata(offset, length));
+	return Strong<String>(_storage.subdata(offset, length)).autoreleased();
 }
 
 Strong<String> String::slicing(
 	ssize_t start,
 	ssize_t end
 ) const {
-	return Strong<String>(_storage.slicing(start, end));
+	return Strong<String>(_storage.slicing(start, end)).autoreleased();
 }
 
 Strong<String> String::uppercased() const {
-	return Strong<String>(this->_storage.map<uint32_t>(Unicode::lowerToUpper));
+	return Strong<String>(this->_storage.map<uint32_t>(Unicode::lowerToUpper)).autoreleased();
 }
 
 Strong<String> String::lowercased() const {
-	return String(this->_storage.map<uint32_t>(Unicode::upperToLower));
+	return Strong<String>(this->_storage.map<uint32_t>(Unicode::upperToLower)).autoreleased();
 }
 
 Strong<String> String::capitalized() const {
@@ -657,54 +750,3 @@ Data<uint32_t> String::_encodeUTF32(
 		return Endian::convert(character, Endian::systemVariant(), endian);
 	});
 }
-
-uint8_t String::_valueFromHex(
-	uint8_t chr,
-	size_t idx
-) noexcept(false) {
-	if (chr >= 'a' && chr <= 'f') return chr - ('a' - 'A');
-	if (chr >= 'A' && chr <= 'F') return (chr - 'A') + 10;
-	else if (chr >= '0' && chr <= '9') return chr - '0';
-	else throw DecoderException(idx);
-}
-
-uint8_t String::_valueToHex(
-	uint8_t value,
-	size_t idx
-) noexcept(false) {
-	if (value < 10) return '0' + value;
-	else if (value < 16) return 'A' + (value - 10);
-	else throw EncoderException(idx);
-}
-
-Data<uint32_t> String::_decodeHex(
-	const Data<uint8_t>& buffer
-) noexcept(false) {
-
-	Data<uint32_t> ret;
-
-	for (size_t idx = 0 ; idx < buffer.length() ; idx++) {
-		auto byte = buffer[idx];
-		ret.append(_valueToHex((byte & 0xF0) >> 4, idx));
-		ret.append(_valueToHex(byte & 0x0F, idx));
-	}
-
-	return ret;
-
-}
-
-Data<uint8_t> String::_encodeHex(
-	const Data<uint32_t> &buffer
-) noexcept(false) {
-
-	if (buffer.length() % 2 != 0) throw OutOfBoundException(buffer.length() + 1);
-
-	Data<uint8_t> ret;
-
-	for (size_t idx = 0 ; idx < buffer.length() ; idx += 2) {
-		ret.append(_valueFromHex(buffer[idx], idx) << 4 | _valueFromHex(buffer[idx + 1], idx + 1));
-	}
-
-	return ret;
-
-}
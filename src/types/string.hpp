@@ -48,7 +48,13 @@ namespace foundation::types {
 		String format(const char* format, ...);
 
 		static Strong<String> fromHex(
-			const Data<uint8_t>& data);
+			const Data<uint8_t>& data,
+			bool uppercase = true);
+
+		static Strong<String> fromBase64(
+			const Data<uint8_t>& data,
+			base64::Alphabet alphabet = base64::Alphabet::standard,
+			bool padding = true);
 
 		static Strong<String> join(
 			const Array<String>& strings);
@@ -94,6 +100,23 @@ namespace foundation::types {
 
 		size_t length() const;
 
+		size_t capacity() const;
+
+		void reserve(
+			size_t capacity);
+
+		void shrinkToFit();
+
+		Growth growth() const;
+
+		void setGrowth(
+			Growth growth);
+
+		bool isChunked() const;
+
+		void setChunked(
+			bool chunked);
+
 		template<typename T>
 		T mapCString(
 			const function<T(const char*)>& todo
@@ -129,6 +152,10 @@ namespace foundation::types {
 
 		Strong<Data<uint8_t>> hexData() const;
 
+		Strong<Data<uint8_t>> base64Data(
+			base64::Alphabet alphabet = base64::Alphabet::standard
+		) const;
+
 		void append(
 			const String& other);
 
@@ -158,6 +185,11 @@ namespace foundation::types {
 			const String& replacement
 		) const;
 
+		Strong<String> replacing(
+			const Array<String>& needles,
+			const String& replacement
+		) const;
+
 		double doubleValue(
 			size_t startIndex = 0,
 			size_t* consumed = nullptr,
@@ -305,24 +337,6 @@ namespace foundation::types {
 			const Data<uint32_t>& buffer,
 			Endian::Variant endian);
 
-		static uint8_t _valueFromHex(
-			uint8_t chr,
-			size_t idx
-		) noexcept(false);
-
-		static uint8_t _valueToHex(
-			uint8_t value,
-			size_t idx
-		) noexcept(false);
-
-		static Data<uint32_t> _decodeHex(
-			const Data<uint8_t>& buffer
-		) noexcept(false);
-
-		static Data<uint8_t> _encodeHex(
-			const Data<uint32_t> &buffer
-		) noexcept(false);
-
 	};
 
 }
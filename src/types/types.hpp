@@ -12,6 +12,7 @@
 #include "./hashable.hpp"
 #include "./comparable.hpp"
 #include "./type.hpp"
+#include "./data-view.hpp"
 #include "./data.hpp"
 #include "./string.hpp"
 #include "./number.hpp"
@@ -107,51 +107,23 @@ UUID& UUID::operator=(
 	return *this;
 }
 
-String UUID::_base64Characters() {
-	return "0123456789abcdef";
-}
-
 String UUID::_encode(
 	uint64_t value
 ) const {
-
 	value = Endian::fromSystemVariant(value, Endian::Variant::big);
-
-	String characters = UUID::_base64Characters();
-
-	String result;
-
-	uint8_t* bytes = (uint8_t*)&value;
-
-	for (size_t idx = 0 ; idx < sizeof(uint64_t) ; idx++) {
-		result = result.appending(String::format("%02x", bytes[idx]));
-	}
-
-	return result;
-
+	return String::fromHex(Data<uint8_t>((const uint8_t*)&value, sizeof(uint64_t)), false);
 }
 
 uint64_t UUID::_decode(
 	const String& string
 ) const noexcept(false) {
 
-	String characters = UUID::_base64Characters();
-
 	uint64_t result = 0;
 
-	uint8_t* bytes = (uint8_t*)&result;
-
-	for (size_t idx = 0 ; idx < sizeof(uint64_t) ; idx++) {
-
-		size_t upperIndex = characters.indexOf(string[idx * 2]);
-		size_t lowerIndex = characters.indexOf(string[idx * 2 + 1]);
-
-		if (upperIndex == NotFound || lowerIndex == NotFound) {
-			throw UUIDMalformedException();
-		}
-
-		bytes[idx] = (upperIndex << 4) | lowerIndex;
-
+	try {
+		memcpy(&result, string.hexData()->items(), sizeof(uint64_t));
+	} catch (const DecoderException&) {
+		throw UUIDMalformedException();
 	}
 
 	return Endian::toSystemVariant(result, Endian::Variant::big);
@@ -54,8 +54,6 @@ namespace foundation::types {
 
 	private:
 
-		static String _base64Characters();
-
 		String _encode(
 			uint64_t value
 		) const;